@@ -0,0 +1,25 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+
+#include <koinos/crypto/elliptic.hpp>
+#include <koinos/crypto/multihash.hpp>
+
+#include <koinos/protocol/protocol.pb.h>
+
+namespace koinos::tools {
+
+// The transaction merkle root the chain expects in a block header. Each transaction contributes two leaves, the
+// hash of its header followed by the hash of its concatenated signatures. Leaves are hashed and combined on up to
+// num_threads threads.
+crypto::multihash transaction_merkle_root( const protocol::block& block, std::size_t num_threads = 1 );
+
+// The id of a block, the hash of its header
+crypto::multihash block_id( const protocol::block_header& header );
+
+// Set the signer, id and signature of a block whose header is otherwise complete, transaction merkle root included.
+// The signature is a compact signature of the id by the signer's key, as the default block signature check expects.
+void sign_block( protocol::block& block, const crypto::private_key& signer );
+
+} // namespace koinos::tools
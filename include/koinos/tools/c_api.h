@@ -0,0 +1,87 @@
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+
+// C interface to koinos_tools for services that sign, build genesis data and generate proofs in process, through
+// cgo, ctypes or any other FFI, instead of running the tools and piping JSON through them.
+//
+// Messages cross the interface as serialized protobuf bytes. Functions return KOINOS_TOOLS_OK on success or
+// KOINOS_TOOLS_ERROR, with a description of the error from koinos_tools_last_error() on the same thread. Buffers
+// returned through out parameters belong to the caller and are released with koinos_tools_free(). All functions
+// may be called from any number of threads at once.
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define KOINOS_TOOLS_OK    0
+#define KOINOS_TOOLS_ERROR 1
+
+// Size of a compressed secp256k1 public key
+#define KOINOS_TOOLS_PUBLIC_KEY_SIZE 33
+
+// A private key, parsed once and reused across calls
+typedef struct koinos_tools_key koinos_tools_key;
+
+// The error of the last failed call on this thread, valid until the next call on this thread
+const char* koinos_tools_last_error( void );
+
+void koinos_tools_free( uint8_t* buffer );
+
+// Parse a base58 WIF private key
+int koinos_tools_key_from_wif( const char* wif, koinos_tools_key** key );
+
+// Read a base58 WIF private key from the first line of a file
+int koinos_tools_key_from_file( const char* filename, koinos_tools_key** key );
+
+void koinos_tools_key_free( koinos_tools_key* key );
+
+// Write the compressed public key of a private key into KOINOS_TOOLS_PUBLIC_KEY_SIZE bytes
+int koinos_tools_key_public_key( const koinos_tools_key* key, uint8_t* public_key );
+
+// Sign a koinos.protocol.transaction with each key, computing its operation merkle root first if finalize is set
+// and the transaction is not already finalized
+int koinos_tools_sign_transaction( const uint8_t* transaction,
+                                   size_t transaction_size,
+                                   const koinos_tools_key* const* keys,
+                                   size_t key_count,
+                                   int finalize,
+                                   uint8_t** signed_transaction,
+                                   size_t* signed_transaction_size );
+
+// Wrap a koinos.protocol.transaction in a koinos.rpc.chain.chain_request submitting it
+int koinos_tools_wrap_transaction( const uint8_t* transaction,
+                                   size_t transaction_size,
+                                   uint8_t** request,
+                                   size_t* request_size );
+
+// The koinos.chain.genesis_data koinos_genesis_tool writes when no spec is given
+int koinos_tools_default_genesis_data( uint8_t** genesis_data, size_t* genesis_data_size );
+
+// Build koinos.chain.genesis_data from a YAML or JSON genesis spec file
+int koinos_tools_load_genesis_spec( const char* path, uint8_t** genesis_data, size_t* genesis_data_size );
+
+// Generate a VRF proof of an input and the multihash of the proof
+int koinos_tools_generate_random_proof( const koinos_tools_key* key,
+                                        const uint8_t* input,
+                                        size_t input_size,
+                                        uint8_t** proof,
+                                        size_t* proof_size,
+                                        uint8_t** proof_hash,
+                                        size_t* proof_hash_size );
+
+// Verify a VRF proof of an input against a compressed public key and the expected proof multihash. A proof that
+// does not verify is not an error, valid is set to 0.
+int koinos_tools_verify_random_proof( const uint8_t* public_key,
+                                      const uint8_t* input,
+                                      size_t input_size,
+                                      const uint8_t* proof,
+                                      size_t proof_size,
+                                      const uint8_t* proof_hash,
+                                      size_t proof_hash_size,
+                                      int* valid );
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,73 @@
+#pragma once
+
+#include <cstdint>
+#include <filesystem>
+#include <functional>
+#include <iostream>
+#include <string>
+
+#include <koinos/chain/chain.pb.h>
+
+#include <koinos/tools/object_keys.hpp>
+
+namespace koinos::tools {
+
+// Load genesis data from a YAML (or JSON) spec file.
+//
+// The spec is a list of entries, each with an optional space (metadata when omitted), a key and a value:
+//
+//   entries:
+//     - key: genesis_key
+//       value: { wif: 5KYPA63Gx4MxQUqDM3PMckvX9nVYDUaLigTKAsLPesTyGmKmbR2 }
+//     - key: resource_limit_data
+//       value:
+//         message: koinos.chain.resource_limit_data
+//         fields: { disk_storage_cost: 10, disk_storage_limit: 409600 }
+//     - key: protocol_descriptor
+//       value: { file: koinos_protocol.pb }
+//     - space: { system: true, zone: { base58: 1Ab... }, id: 0 }
+//       key: { base58: 1Ab... }
+//       value: { file: contract.wasm }
+//
+// A space is a system space name or id, or a map of system, zone and id. A key is an object key name or a byte
+// value. Byte values are one of address (base58), base58, base64, hex, string, hash (sha2_256 of a string),
+// varint, wif (the address of the key), message with fields (a protobuf message by full name, fields as in its
+// JSON mapping) or file with an optional encoding of binary, hex or base64. Files are relative to the spec.
+chain::genesis_data load_genesis_spec( const std::filesystem::path& path );
+
+// The genesis data used when no spec is given: the development genesis key, resource limits, compute registry and
+// protocol descriptor
+chain::genesis_data default_genesis_data();
+
+// The resource costs and per block limits in the default genesis
+chain::resource_limit_data default_resource_limit_data();
+
+// The compute cost of each thunk in the default genesis
+chain::compute_bandwidth_registry default_compute_bandwidth_registry();
+
+// Encodings of a stream of genesis entries
+enum class genesis_format
+{
+  automatic, // json if the stream starts with '{', binary otherwise
+  json,      // the JSON of a genesis_data message
+  binary     // varint length delimited genesis_entry messages
+};
+
+genesis_format parse_genesis_format( const std::string& name );
+
+// Read genesis entries from a stream one at a time, so inputs of any size can be processed without being held in
+// memory. Returns the number of entries read.
+uint64_t read_genesis_entries( std::istream& stream,
+                               genesis_format format,
+                               const std::function< void( chain::genesis_entry& ) >& handler );
+
+// The entry holding an account's balance in a token contract's balance space
+chain::genesis_entry account_balance_entry( const std::string& token_contract,
+                                            uint32_t space_id,
+                                            const std::string& address,
+                                            uint64_t balance );
+
+// The entry holding the last nonce used by an account
+chain::genesis_entry account_nonce_entry( const std::string& address, uint64_t nonce );
+
+} // namespace koinos::tools
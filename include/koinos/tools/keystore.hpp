@@ -0,0 +1,76 @@
+#pragma once
+
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <optional>
+#include <string>
+#include <vector>
+
+#include <koinos/crypto/elliptic.hpp>
+
+namespace koinos::tools {
+
+// The development key koinos_get_dev_key generates at an index of a seed, the private key of sha2_256( seed, index )
+crypto::private_key derive_dev_key( const std::string& seed, uint64_t index );
+
+// A binary file of private keys with an index sorted by address.
+//
+// The layout is fixed size and little endian so the file can be memory mapped:
+//
+//   header   magic "KOINOSKS", uint32 version, uint32 reserved, uint64 count, uint64 reserved
+//   keys     count 32 byte secrets, in generation order
+//   index    count entries of a 25 byte address, 7 bytes of padding and the uint64 key index, sorted by address
+namespace keystore_layout {
+
+constexpr char magic[]                 = "KOINOSKS";
+constexpr uint32_t version             = 1;
+constexpr std::size_t header_size      = 32;
+constexpr std::size_t secret_size      = 32;
+constexpr std::size_t address_size     = 25;
+constexpr std::size_t index_entry_size = 40;
+
+} // namespace keystore_layout
+
+// Writes a keystore, keys must be added in index order
+class keystore_writer
+{
+public:
+  explicit keystore_writer( const std::filesystem::path& path );
+
+  // Add a key with its address, derived by the caller so the costly public key derivation can happen on any thread
+  void add( const crypto::private_key& key, std::string address );
+
+  // Sorts and writes the address index, the file is not a valid keystore until this is called
+  void close();
+
+  uint64_t size() const;
+
+private:
+  std::filesystem::path _path;
+  std::ofstream _stream;
+  std::vector< std::pair< std::string, uint64_t > > _index;
+};
+
+// Reads keys from a keystore without loading it into memory
+class keystore
+{
+public:
+  explicit keystore( const std::filesystem::path& path );
+
+  uint64_t size() const;
+
+  crypto::private_key at( uint64_t index );
+
+  // Binary searches the address index, returning the index of the key for the address
+  std::optional< uint64_t > find( const std::string& address );
+
+private:
+  std::string read( uint64_t offset, std::size_t size );
+
+  std::filesystem::path _path;
+  std::ifstream _stream;
+  uint64_t _size = 0;
+};
+
+} // namespace koinos::tools
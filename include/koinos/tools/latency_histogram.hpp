@@ -0,0 +1,46 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+
+namespace koinos::tools {
+
+// A fixed size log-linear histogram of durations, safe to record into from many threads.
+//
+// Values below 16ns get their own bucket, larger values are grouped into 16 buckets per power of two,
+// which bounds the error of any reported percentile to about 6%.
+class latency_histogram
+{
+public:
+  void record( std::chrono::nanoseconds duration );
+
+  // Add the samples of another histogram to this one
+  void merge( const latency_histogram& other );
+
+  void reset();
+
+  uint64_t count() const;
+  std::chrono::nanoseconds total() const;
+  std::chrono::nanoseconds max() const;
+  std::chrono::nanoseconds mean() const;
+
+  // The duration below which the given fraction (0 to 1) of samples fall
+  std::chrono::nanoseconds percentile( double fraction ) const;
+
+private:
+  static constexpr std::size_t sub_bucket_bits  = 4;
+  static constexpr std::size_t sub_bucket_count = 1 << sub_bucket_bits;
+  static constexpr std::size_t bucket_count     = ( 64 - sub_bucket_bits + 1 ) * sub_bucket_count;
+
+  static std::size_t bucket_index( uint64_t value );
+  static uint64_t bucket_midpoint( std::size_t index );
+
+  std::array< std::atomic< uint64_t >, bucket_count > _buckets{};
+  std::atomic< uint64_t > _count = 0;
+  std::atomic< uint64_t > _total = 0;
+  std::atomic< uint64_t > _max   = 0;
+};
+
+} // namespace koinos::tools
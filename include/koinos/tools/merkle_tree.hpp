@@ -0,0 +1,87 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <vector>
+
+#include <koinos/crypto/multihash.hpp>
+
+#include <google/protobuf/repeated_ptr_field.h>
+
+namespace koinos::tools {
+
+// The hashes needed to recompute a merkle root from one leaf, ordered from the leaves up
+struct merkle_proof
+{
+  uint64_t index  = 0; // Index of the leaf
+  uint64_t leaves = 0; // Number of leaves in the tree
+  std::vector< crypto::multihash > siblings;
+};
+
+// A merkle tree producing the same roots as crypto::merkle_tree over already hashed leaves: parents hash the
+// concatenated digests of their children and the last node of an odd sized level is promoted unchanged.
+//
+// Each level is kept as one flat array of digests rather than a tree of nodes, so building a large tree makes a few
+// allocations instead of one per node. Appending or replacing a leaf rehashes only its path to the root.
+class merkle_tree
+{
+public:
+  explicit merkle_tree( crypto::multicodec code = crypto::multicodec::sha2_256 );
+
+  // Build from hashed leaves, combining large levels on up to num_threads threads
+  merkle_tree( crypto::multicodec code, const std::vector< crypto::multihash >& leaves, std::size_t num_threads = 1 );
+
+  // Build from count leaves computed by leaf( index ), computing leaves and combining large levels on up to
+  // num_threads threads
+  static merkle_tree generate( crypto::multicodec code,
+                               std::size_t count,
+                               const std::function< crypto::multihash( std::size_t ) >& leaf,
+                               std::size_t num_threads = 1 );
+
+  // Build from messages, hashing each into a leaf and combining large levels on up to num_threads threads
+  template< typename Message >
+  static merkle_tree from_messages( crypto::multicodec code,
+                                    const google::protobuf::RepeatedPtrField< Message >& messages,
+                                    std::size_t num_threads = 1 )
+  {
+    return generate(
+      code,
+      messages.size(),
+      [ & ]( std::size_t index )
+      {
+        return crypto::hash( code, messages.Get( int( index ) ) );
+      },
+      num_threads );
+  }
+
+  std::size_t size() const;
+
+  crypto::multihash root() const;
+  crypto::multihash leaf( std::size_t index ) const;
+
+  void append( const crypto::multihash& leaf );
+  void replace( std::size_t index, const crypto::multihash& leaf );
+
+  merkle_proof proof( std::size_t index ) const;
+
+private:
+  void
+  build( std::size_t count, std::size_t num_threads, const std::function< crypto::multihash( std::size_t ) >& leaf );
+  void set_leaf( std::size_t index, const crypto::multihash& leaf );
+  void update_path( std::size_t index );
+  void combine( std::size_t level, std::size_t index );
+  crypto::multihash node( std::size_t level, std::size_t index ) const;
+
+  crypto::multicodec _code;
+  std::size_t _digest_size = 0;
+  std::vector< std::vector< std::byte > > _levels; // _levels[ 0 ] holds the leaves, the last level the root
+};
+
+// Recompute the root from a leaf and its proof and compare it to the expected root
+bool verify_merkle_proof( crypto::multicodec code,
+                          const crypto::multihash& leaf,
+                          const merkle_proof& proof,
+                          const crypto::multihash& root );
+
+} // namespace koinos::tools
@@ -0,0 +1,190 @@
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <string_view>
+
+#include <koinos/chain/chain.pb.h>
+#include <koinos/chain/object_spaces.pb.h>
+
+namespace koinos::tools {
+
+namespace detail {
+
+constexpr std::array< uint32_t, 64 > sha256_round_constants = {
+  0x428a2f98, 0x71374491, 0xb5c0fbcf, 0xe9b5dba5, 0x3956c25b, 0x59f111f1, 0x923f82a4, 0xab1c5ed5,
+  0xd807aa98, 0x12835b01, 0x243185be, 0x550c7dc3, 0x72be5d74, 0x80deb1fe, 0x9bdc06a7, 0xc19bf174,
+  0xe49b69c1, 0xefbe4786, 0x0fc19dc6, 0x240ca1cc, 0x2de92c6f, 0x4a7484aa, 0x5cb0a9dc, 0x76f988da,
+  0x983e5152, 0xa831c66d, 0xb00327c8, 0xbf597fc7, 0xc6e00bf3, 0xd5a79147, 0x06ca6351, 0x14292967,
+  0x27b70a85, 0x2e1b2138, 0x4d2c6dfc, 0x53380d13, 0x650a7354, 0x766a0abb, 0x81c2c92e, 0x92722c85,
+  0xa2bfe8a1, 0xa81a664b, 0xc24b8b70, 0xc76c51a3, 0xd192e819, 0xd6990624, 0xf40e3585, 0x106aa070,
+  0x19a4c116, 0x1e376c08, 0x2748774c, 0x34b0bcb5, 0x391c0cb3, 0x4ed8aa4a, 0x5b9cca4f, 0x682e6ff3,
+  0x748f82ee, 0x78a5636f, 0x84c87814, 0x8cc70208, 0x90befffa, 0xa4506ceb, 0xbef9a3f7, 0xc67178f2 };
+
+constexpr uint32_t rotr( uint32_t x, int n )
+{
+  return ( x >> n ) | ( x << ( 32 - n ) );
+}
+
+// The sha2_256 digest of prefix followed by message, evaluated at compile time for key names
+constexpr std::array< uint8_t, 32 > sha256( std::string_view prefix, std::string_view message )
+{
+  std::array< uint32_t, 8 > state = { 0x6a09e667,
+                                      0xbb67ae85,
+                                      0x3c6ef372,
+                                      0xa54ff53a,
+                                      0x510e527f,
+                                      0x9b05688c,
+                                      0x1f83d9ab,
+                                      0x5be0cd19 };
+
+  const uint64_t length = prefix.size() + message.size();
+  const uint64_t padded = ( ( length + 8 ) / 64 + 1 ) * 64;
+
+  auto byte_at = [ & ]( uint64_t i ) -> uint32_t
+  {
+    if( i < prefix.size() )
+      return uint8_t( prefix[ i ] );
+    if( i < length )
+      return uint8_t( message[ i - prefix.size() ] );
+    if( i == length )
+      return 0x80;
+    if( i >= padded - 8 )
+      return uint8_t( ( length * 8 ) >> ( 8 * ( padded - 1 - i ) ) );
+    return 0;
+  };
+
+  for( uint64_t block = 0; block < padded; block += 64 )
+  {
+    std::array< uint32_t, 64 > w{};
+    for( std::size_t t = 0; t < 16; t++ )
+      w[ t ] = byte_at( block + 4 * t ) << 24 | byte_at( block + 4 * t + 1 ) << 16 | byte_at( block + 4 * t + 2 ) << 8
+               | byte_at( block + 4 * t + 3 );
+
+    for( std::size_t t = 16; t < 64; t++ )
+    {
+      uint32_t s0 = rotr( w[ t - 15 ], 7 ) ^ rotr( w[ t - 15 ], 18 ) ^ ( w[ t - 15 ] >> 3 );
+      uint32_t s1 = rotr( w[ t - 2 ], 17 ) ^ rotr( w[ t - 2 ], 19 ) ^ ( w[ t - 2 ] >> 10 );
+      w[ t ]      = w[ t - 16 ] + s0 + w[ t - 7 ] + s1;
+    }
+
+    auto [ a, b, c, d, e, f, g, h ] = state;
+
+    for( std::size_t t = 0; t < 64; t++ )
+    {
+      uint32_t s1    = rotr( e, 6 ) ^ rotr( e, 11 ) ^ rotr( e, 25 );
+      uint32_t ch    = ( e & f ) ^ ( ~e & g );
+      uint32_t temp1 = h + s1 + ch + sha256_round_constants[ t ] + w[ t ];
+      uint32_t s0    = rotr( a, 2 ) ^ rotr( a, 13 ) ^ rotr( a, 22 );
+      uint32_t maj   = ( a & b ) ^ ( a & c ) ^ ( b & c );
+
+      h = g;
+      g = f;
+      f = e;
+      e = d + temp1;
+      d = c;
+      c = b;
+      b = a;
+      a = temp1 + s0 + maj;
+    }
+
+    state[ 0 ] += a;
+    state[ 1 ] += b;
+    state[ 2 ] += c;
+    state[ 3 ] += d;
+    state[ 4 ] += e;
+    state[ 5 ] += f;
+    state[ 6 ] += g;
+    state[ 7 ] += h;
+  }
+
+  std::array< uint8_t, 32 > digest{};
+  for( std::size_t i = 0; i < 32; i++ )
+    digest[ i ] = uint8_t( state[ i / 4 ] >> ( 24 - 8 * ( i % 4 ) ) );
+
+  return digest;
+}
+
+constexpr bool digest_equals( const std::array< uint8_t, 32 >& digest, const std::array< uint8_t, 32 >& expected )
+{
+  for( std::size_t i = 0; i < digest.size(); i++ )
+  {
+    if( digest[ i ] != expected[ i ] )
+      return false;
+  }
+
+  return true;
+}
+
+// FIPS 180-2 test vectors, a single block message and one whose padding spills into a second block, split between
+// prefix and message to cover reading across them
+static_assert( digest_equals( sha256( "", "abc" ),
+                              { 0xba, 0x78, 0x16, 0xbf, 0x8f, 0x01, 0xcf, 0xea, 0x41, 0x41, 0x40,
+                                0xde, 0x5d, 0xae, 0x22, 0x23, 0xb0, 0x03, 0x61, 0xa3, 0x96, 0x17,
+                                0x7a, 0x9c, 0xb4, 0x10, 0xff, 0x61, 0xf2, 0x00, 0x15, 0xad } ) );
+static_assert( digest_equals( sha256( "abcdbcdecdefdefg", "efghfghighijhijkijkljklmklmnlmnomnopnopq" ),
+                              { 0x24, 0x8d, 0x6a, 0x61, 0xd2, 0x06, 0x38, 0xb8, 0xe5, 0xc0, 0x26,
+                                0x93, 0x0c, 0x3e, 0x60, 0x39, 0xa3, 0x3c, 0xe4, 0x59, 0x64, 0xff,
+                                0x21, 0x67, 0xf6, 0xec, 0xed, 0xd4, 0x19, 0xdb, 0x06, 0xc1 } ) );
+
+} // namespace detail
+
+// Objects the kernel keeps in the metadata space
+enum class kernel_object : std::size_t
+{
+  genesis_key,
+  resource_limit_data,
+  max_account_resources,
+  protocol_descriptor,
+  compute_bandwidth_registry,
+  block_hash_code
+};
+
+constexpr std::array< std::string_view, 6 > kernel_object_names = { "genesis_key",
+                                                                    "resource_limit_data",
+                                                                    "max_account_resources",
+                                                                    "protocol_descriptor",
+                                                                    "compute_bandwidth_registry",
+                                                                    "block_hash_code" };
+
+constexpr std::string_view object_key_prefix = "object_key::";
+
+// The sha2_256 digests of "object_key::<name>" for each kernel object, computed at compile time
+constexpr auto kernel_object_digests = []()
+{
+  std::array< std::array< uint8_t, 32 >, kernel_object_names.size() > digests{};
+  for( std::size_t i = 0; i < kernel_object_names.size(); i++ )
+    digests[ i ] = detail::sha256( object_key_prefix, kernel_object_names[ i ] );
+  return digests;
+}();
+
+// The genesis key as crypto::hash( sha2_256, std::string( "object_key::genesis_key" ) ) has always produced it
+static_assert( detail::digest_equals( kernel_object_digests[ std::size_t( kernel_object::genesis_key ) ],
+                                      { 0xb7, 0x9c, 0xef, 0x97, 0x6d, 0xe2, 0xa0, 0xe0, 0x2f, 0x2e, 0x81,
+                                        0x6e, 0xcc, 0xed, 0x77, 0x5f, 0x98, 0x92, 0x98, 0xe2, 0x2d, 0xe5,
+                                        0xf7, 0x52, 0xa8, 0x25, 0x6c, 0x68, 0xb1, 0x03, 0xc8, 0x98 } ) );
+
+constexpr std::string_view object_name( kernel_object object )
+{
+  return kernel_object_names[ std::size_t( object ) ];
+}
+
+// The key of a kernel object as stored in state
+const std::string& object_key( kernel_object object );
+
+// The key of an object by name, the kernel object table is used for known names and others are hashed
+std::string object_key( const std::string& name );
+
+// Look up a kernel object by name or by its key
+std::optional< kernel_object > find_kernel_object( std::string_view name );
+std::optional< kernel_object > find_kernel_object_by_key( const std::string& key );
+
+// A system space in the kernel zone
+chain::object_space system_space( chain::system_space_id id );
+
+// The name of a system space, or an empty string for contract spaces and unknown ids
+std::string space_name( const chain::object_space& space );
+
+} // namespace koinos::tools
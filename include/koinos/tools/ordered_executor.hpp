@@ -0,0 +1,192 @@
+#pragma once
+
+#include <algorithm>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <optional>
+#include <thread>
+#include <utility>
+#include <vector>
+
+namespace koinos::tools {
+
+// Runs work on a pool of threads and hands results to a sink in the order their inputs were pushed.
+//
+// At most queue_depth items are in flight (queued, being worked or waiting to be emitted) at any time,
+// push() blocks once that limit is reached so memory use does not grow with the size of the input.
+// The sink is never called concurrently. Work receives the index of the worker running it so callers
+// can keep per-thread scratch state without locking.
+template< typename Input, typename Output >
+class ordered_executor
+{
+public:
+  using work_function = std::function< Output( Input&, std::size_t ) >;
+  using sink_function = std::function< void( Output& ) >;
+
+  ordered_executor( std::size_t num_threads, std::size_t queue_depth, work_function work, sink_function sink ):
+      _work( std::move( work ) ),
+      _sink( std::move( sink ) ),
+      _results( std::max< std::size_t >( queue_depth, 1 ) )
+  {
+    num_threads = std::max< std::size_t >( num_threads, 1 );
+    _workers.reserve( num_threads );
+
+    for( std::size_t i = 0; i < num_threads; i++ )
+      _workers.emplace_back( &ordered_executor::worker_main, this, i );
+  }
+
+  ordered_executor( const ordered_executor& )            = delete;
+  ordered_executor& operator=( const ordered_executor& ) = delete;
+
+  ~ordered_executor()
+  {
+    stop();
+  }
+
+  // Queue an input, blocking while the executor is at capacity
+  void push( Input input )
+  {
+    std::unique_lock lock( _mutex );
+    _space_cv.wait( lock,
+                    [ & ]()
+                    {
+                      return _next_push - _next_emit < _results.size() || _error;
+                    } );
+
+    if( _error )
+      std::rethrow_exception( _error );
+
+    _queue.emplace_back( _next_push++, std::move( input ) );
+    _work_cv.notify_one();
+  }
+
+  // Wait for all queued work to be emitted and join the workers, rethrowing the first failure
+  void finish()
+  {
+    stop();
+
+    if( _error )
+      std::rethrow_exception( _error );
+  }
+
+  static std::size_t default_concurrency()
+  {
+    return std::max< std::size_t >( std::thread::hardware_concurrency(), 1 );
+  }
+
+private:
+  void stop()
+  {
+    {
+      std::lock_guard lock( _mutex );
+      _done = true;
+    }
+
+    _work_cv.notify_all();
+
+    for( auto& worker: _workers )
+    {
+      if( worker.joinable() )
+        worker.join();
+    }
+  }
+
+  void worker_main( std::size_t index )
+  {
+    std::unique_lock lock( _mutex );
+
+    for( ;; )
+    {
+      _work_cv.wait( lock,
+                     [ & ]()
+                     {
+                       return !_queue.empty() || _done;
+                     } );
+
+      if( _queue.empty() )
+        return;
+
+      auto [ sequence, input ] = std::move( _queue.front() );
+      _queue.pop_front();
+
+      if( _error )
+        continue;
+
+      lock.unlock();
+
+      std::optional< Output > output;
+
+      try
+      {
+        output.emplace( _work( input, index ) );
+      }
+      catch( ... )
+      {
+        lock.lock();
+        if( !_error )
+          _error = std::current_exception();
+        _space_cv.notify_all();
+        continue;
+      }
+
+      lock.lock();
+      _results[ sequence % _results.size() ] = std::move( output );
+
+      // Only one worker drains the reorder buffer at a time, any other worker finishing
+      // the next item in order while the sink runs will be picked up by the drain loop
+      if( _emitting )
+        continue;
+
+      _emitting = true;
+
+      while( auto& slot = _results[ _next_emit % _results.size() ] )
+      {
+        auto result = std::move( *slot );
+        slot.reset();
+        lock.unlock();
+
+        try
+        {
+          _sink( result );
+        }
+        catch( ... )
+        {
+          lock.lock();
+          if( !_error )
+            _error = std::current_exception();
+          break;
+        }
+
+        lock.lock();
+        _next_emit++;
+        _space_cv.notify_all();
+      }
+
+      _emitting = false;
+      _space_cv.notify_all();
+    }
+  }
+
+  work_function _work;
+  sink_function _sink;
+
+  std::mutex _mutex;
+  std::condition_variable _work_cv;
+  std::condition_variable _space_cv;
+
+  std::deque< std::pair< uint64_t, Input > > _queue;
+  std::vector< std::optional< Output > > _results;
+  std::vector< std::thread > _workers;
+
+  uint64_t _next_push = 0;
+  uint64_t _next_emit = 0;
+  bool _emitting      = false;
+  bool _done          = false;
+  std::exception_ptr _error;
+};
+
+} // namespace koinos::tools
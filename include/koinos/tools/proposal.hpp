@@ -0,0 +1,49 @@
+#pragma once
+
+#include <filesystem>
+#include <string>
+
+#include <koinos/protocol/protocol.pb.h>
+
+namespace koinos::tools {
+
+// Entry point of the governance contract's submit_proposal
+const uint32_t SUBMIT_PROPOSAL_ENTRY_POINT = 0xe74b785c;
+
+struct proposal
+{
+  std::string id; // The operation merkle root of the proposed operations, empty when not submitted to governance
+  protocol::transaction transaction;
+};
+
+// Build an unsigned transaction from a YAML (or JSON) proposal file.
+//
+// The file gives the transaction header and a list of operations. When governance is set the operations are wrapped
+// in a submit_proposal call to that contract with the given fee, otherwise they are the transaction's operations:
+//
+//   chain_id: { base64: EiBncD4pKRIQWco_WRqo5Q-xnXR7JuO3PtZv983mKdKHSQ== }
+//   payer: 147ABaHVxtpoSpfpZ8yry7eaFAjV87trGR
+//   nonce: 8
+//   rc_limit: 10000000
+//   governance: 17MjUXDCuTX1p9Kyqy48SQkkPfKScoggo
+//   fee: 6000000000
+//   operations:
+//     - set_system_contract: { contract_id: 1HnCM6v2bLg8Qhw6BKCVhGPeoTamJbkbFi, system_contract: true }
+//     - set_system_call:
+//         call_id: get_account_rc
+//         contract_id: 1HnCM6v2bLg8Qhw6BKCVhGPeoTamJbkbFi
+//         entry_point: 0x2d464aab
+//     - call_contract:
+//         contract_id: 13NQnca5chwpKm4ebHbvgvJmXrsSCTayDJ
+//         entry_point: 0xe248c73a
+//         args:
+//           message: koinos.contracts.name_service.set_record_arguments
+//           fields: { name: koin, address: ALgOM9VRFk03Xtt1XI-slW3RbWhfjHG6FQ== }
+//
+// Addresses (payer, an optional payee, governance and contract_id) are base58 strings or byte values, chain_id and
+// args are byte values as in load_genesis_spec. A set_system_call targets either a contract_id and entry_point or a
+// thunk_id, its call_id is a system call name or id. The nonce is that of the payee when one is set, of the payer
+// otherwise. The operation merkle root and transaction id are set, so the transaction is ready to sign.
+proposal load_proposal_spec( const std::filesystem::path& path );
+
+} // namespace koinos::tools
@@ -0,0 +1,122 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <iostream>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include <google/protobuf/message.h>
+#include <google/protobuf/util/json_util.h>
+
+namespace koinos::tools {
+
+class rc_estimator;
+
+// Encodings for transactions read and written by the tools
+enum class record_format
+{
+  json,    // json, pretty printed on output
+  compact, // json on a single line
+  binary,  // varint length delimited protobuf
+  base64   // base64 encoded protobuf, one per line
+};
+
+record_format parse_record_format( const std::string& name );
+
+struct record_options
+{
+  record_format input           = record_format::json;
+  record_format output          = record_format::json;
+  bool wrap                     = false;   // Output records are rpc::chain::chain_request
+  bool unwrap                   = false;   // Input records are rpc::chain::chain_request
+  bool finalize                 = false;   // Compute the operation merkle root before signing
+  bool delimited                = true;    // Prefix binary output with its length, unset when the transport frames it
+  const rc_estimator* estimator = nullptr; // Set the rc_limit of transactions without one before signing
+  google::protobuf::util::JsonParseOptions json_opts;
+  google::protobuf::util::JsonPrintOptions print_options;
+};
+
+// Options for the given formats with the json settings shared by all tools
+record_options make_record_options( record_format input, record_format output );
+
+// Reads whole input records from a stream without parsing them so parsing can happen on worker threads. Binary
+// records are read straight from the stream's buffer, so the only input held back is what that buffer holds.
+class record_reader
+{
+public:
+  record_reader( record_format format, std::istream& stream = std::cin );
+
+  // Read the next record, returns false on EOF
+  bool next( std::string& record );
+
+  // Line number of the last text record, or index of the last binary record
+  uint64_t position() const;
+
+  // True when no more input is buffered, so the next read may wait on the producer
+  bool caught_up() const;
+
+private:
+  record_format _format;
+  std::istream& _stream;
+  uint64_t _position = 0;
+};
+
+// Decides when output written from an ordered executor's sink is flushed, without the sink touching the input.
+// The reading thread reports each record before queueing it, noting whether the input had caught up with its
+// producer. The sink flushes after the result of such a record, when the producer may be waiting on it, rather
+// than once per record.
+class output_flusher
+{
+public:
+  // Called by the reading thread for each record, before the record is queued
+  void record_read( bool caught_up );
+
+  // Called by the sink after writing each result in order, true if the output should be flushed now
+  bool record_written();
+
+private:
+  std::atomic< uint64_t > _flush_through = 0;
+  uint64_t _read                         = 0; // Only used by the reading thread
+  uint64_t _written                      = 0; // Only used by the sink
+};
+
+// Memory maps a file of records and indexes where each one starts, so records can be read in any order and a run
+// over the file can resume at any record without reading the ones before it. The index holds one offset per record.
+// Text records are numbered by record rather than line, blank lines are not counted.
+class mapped_records
+{
+public:
+  mapped_records( const std::string& filename, record_format format );
+  ~mapped_records();
+
+  mapped_records( const mapped_records& )            = delete;
+  mapped_records& operator=( const mapped_records& ) = delete;
+
+  // Number of records in the file
+  std::size_t size() const;
+
+  // Size of the file in bytes
+  uint64_t file_size() const;
+
+  // The whole file, valid while this object lives
+  std::string_view contents() const;
+
+  // The record at index, without its delimiter, valid while this object lives
+  std::string_view record( std::size_t index ) const;
+
+private:
+  record_format _format;
+  const char* _data = nullptr;
+  std::size_t _size = 0;
+  std::vector< uint64_t > _offsets;
+};
+
+// Deserialize a record into the given message
+void parse_record( const std::string& record, const record_options& opts, google::protobuf::Message& message );
+
+// Serialize a message as a complete output record, including its delimiter
+void serialize_record( const google::protobuf::Message& message, const record_options& opts, std::string& record );
+
+} // namespace koinos::tools
@@ -0,0 +1,83 @@
+#pragma once
+
+#include <cstdint>
+#include <iostream>
+#include <string>
+
+#include <koinos/chain/chain.pb.h>
+#include <koinos/protocol/protocol.pb.h>
+
+#include <koinos/tools/genesis.hpp>
+
+namespace koinos::tools {
+
+struct resource_usage
+{
+  uint64_t disk_storage      = 0;
+  uint64_t network_bandwidth = 0;
+  uint64_t compute_bandwidth = 0;
+};
+
+struct resource_estimate
+{
+  resource_usage usage;
+  uint64_t rc         = 0;     // The resource cost of the usage
+  uint64_t rc_limit   = 0;     // The cost with the margin applied, what to set as the transaction's rc_limit
+  bool exceeds_limits = false; // The usage does not fit in a block under the per block limits
+};
+
+// Estimates the resources a transaction consumes without applying it, from its serialized sizes, the costs in
+// resource_limit_data and the thunk costs in the compute_bandwidth_registry.
+//
+// Network bandwidth is the size of the transaction once finalized and signed. Compute bandwidth sums the thunks the
+// chain charges for every transaction (nonce and rc handling, id and merkle root hashing, signature recovery) and
+// for each operation. Disk storage counts the objects the operations and the nonce update write. Contract execution
+// cannot be simulated offline, each call_contract operation is charged call_compute on top of the calling thunks,
+// so the estimate is a lower bound for calls unless call_compute covers the called entry points.
+//
+// Thunk costs are resolved once on construction, estimates do not allocate and can run on any number of threads.
+class rc_estimator
+{
+public:
+  rc_estimator( const chain::resource_limit_data& limits, const chain::compute_bandwidth_registry& registry );
+
+  // The resource limits and registry of the default genesis
+  rc_estimator();
+
+  // Read the resource limits and registry from a genesis file, falling back to the defaults for missing entries
+  static rc_estimator from_genesis( std::istream& stream, genesis_format format );
+  static rc_estimator from_genesis( const chain::genesis_data& data );
+
+  // Compute charged for each call_contract operation on top of the calling thunks
+  void set_call_compute( uint64_t compute );
+
+  // Percentage added to the estimated rc when computing rc_limit
+  void set_margin( double percent );
+
+  // Estimate a transaction as it will be once it carries additional_signatures more signatures
+  resource_estimate estimate( const protocol::transaction& transaction, std::size_t additional_signatures = 0 ) const;
+
+  const chain::resource_limit_data& limits() const;
+
+private:
+  struct thunk_costs
+  {
+    uint64_t transaction_base     = 0; // Charged once per transaction
+    uint64_t recover_public_key   = 0;
+    uint64_t sha2_256_base        = 0;
+    uint64_t sha2_256_per_byte    = 0;
+    uint64_t deserialize_per_byte = 0;
+    uint64_t verify_merkle_root   = 0;
+    uint64_t upload_contract      = 0;
+    uint64_t call_contract        = 0;
+    uint64_t set_system_call      = 0;
+    uint64_t set_system_contract  = 0;
+  };
+
+  chain::resource_limit_data _limits;
+  thunk_costs _costs;
+  uint64_t _call_compute = 0;
+  double _margin         = 0;
+};
+
+} // namespace koinos::tools
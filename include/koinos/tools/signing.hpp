@@ -0,0 +1,81 @@
+#pragma once
+
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <vector>
+
+#include <google/protobuf/struct.pb.h>
+
+#include <koinos/crypto/elliptic.hpp>
+
+#include <koinos/protocol/protocol.pb.h>
+#include <koinos/rpc/chain/chain_rpc.pb.h>
+
+#include <koinos/tools/records.hpp>
+
+namespace koinos::tools {
+
+// Scratch messages reused across records by a single thread
+struct sign_context
+{
+  protocol::transaction transaction;
+  rpc::chain::chain_request request;
+  google::protobuf::Value error;
+};
+
+// A record to sign. The transaction is only parsed up front when something must be done to it in input order,
+// such as nonce assignment.
+struct sign_job
+{
+  uint64_t position = 0;
+  std::string record;
+  std::optional< protocol::transaction > transaction;
+  std::string error;
+};
+
+// Append a signature unless the transaction already carries it. Signing is deterministic,
+// so a key that already signed this transaction produces identical signature bytes.
+bool add_signature( protocol::transaction& transaction, const std::string& signature );
+
+// Add a signature to the transaction from each of the given keys. Signatures over a header other than the current
+// one are dropped, since they would no longer verify.
+void sign_transaction( protocol::transaction& transaction, const std::vector< crypto::private_key >& signing_keys );
+
+// Move a transaction into a submit_transaction request, the form the chain RPC accepts
+void wrap_transaction( protocol::transaction& transaction, rpc::chain::chain_request& request );
+
+// Move the transaction out of a submit_transaction request
+void unwrap_transaction( rpc::chain::chain_request& request, protocol::transaction& transaction );
+
+// Read a base58 WIF private key from the given file
+crypto::private_key read_keyfile( std::string key_filename );
+
+// Read every base58 WIF private key from the given file, one per line
+std::vector< crypto::private_key > read_keyring( const std::string& keyring_filename );
+
+// Parse the transaction in a record into ctx.transaction
+void read_transaction( const std::string& record, const record_options& opts, sign_context& ctx );
+
+// Apply the changes the options make to a transaction before it is signed with the given number of keys: setting a
+// missing rc_limit from an estimate, then finalizing
+void prepare_transaction( protocol::transaction& transaction, const record_options& opts, std::size_t signing_keys );
+
+// Serialize ctx.transaction as an output record, wrapping it in a request if requested
+void write_transaction( const record_options& opts, sign_context& ctx, std::string& output );
+
+// Write an error in place of a failed record so output records stay aligned with input records
+void write_error( uint64_t position,
+                  const std::string& what,
+                  const record_options& opts,
+                  sign_context& ctx,
+                  std::string& output );
+
+// Sign a single job into output, or write an error record in its place. Returns false on error.
+bool sign_record( sign_job& job,
+                  const std::vector< crypto::private_key >& signing_keys,
+                  const record_options& opts,
+                  sign_context& ctx,
+                  std::string& output );
+
+} // namespace koinos::tools
@@ -0,0 +1,117 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <ostream>
+#include <string>
+#include <thread>
+
+#include <boost/program_options.hpp>
+
+namespace koinos::tools {
+
+// Stages of the tools' pipelines that are timed when stats are enabled
+enum class stage : std::size_t
+{
+  key_load,  // reading, deriving or decoding private keys
+  parse,     // decoding input records into messages
+  hash,      // hashing headers, operations and merkle trees
+  sign,      // creating signatures and proofs
+  verify,    // recovering keys and checking proofs
+  serialize, // encoding messages into output records
+  write      // writing output records
+};
+
+constexpr std::size_t stage_count = std::size_t( stage::write ) + 1;
+
+const char* stage_name( stage s );
+
+// Encodings of a stats report
+enum class stats_format
+{
+  json,      // a single json object
+  prometheus // the Prometheus text exposition format
+};
+
+stats_format parse_stats_format( const std::string& name );
+
+// Turn collection on or off for the whole process. While off, a stage timer costs a single relaxed load.
+void enable_stats( bool enabled = true );
+
+bool stats_enabled();
+
+// Add bytes a stage processed, such as the size of the records written, to the calling thread's counters
+void add_stage_bytes( stage s, uint64_t bytes );
+
+// Time a stage from construction to destruction into the calling thread's histogram of that stage.
+//
+// Each thread records into its own histograms, which are only merged when a report is written, so workers timing
+// the same stage do not contend with each other.
+class stage_timer
+{
+public:
+  explicit stage_timer( stage s ):
+      _stage( s ),
+      _active( stats_enabled() )
+  {
+    if( _active )
+      _start = std::chrono::steady_clock::now();
+  }
+
+  ~stage_timer()
+  {
+    if( _active )
+      record( _stage, std::chrono::steady_clock::now() - _start );
+  }
+
+  stage_timer( const stage_timer& )            = delete;
+  stage_timer& operator=( const stage_timer& ) = delete;
+
+  static void record( stage s, std::chrono::nanoseconds duration );
+
+private:
+  stage _stage;
+  bool _active;
+  std::chrono::steady_clock::time_point _start;
+};
+
+// Write the stats of every thread that recorded any, merged per stage. Throughput is per second since stats were
+// enabled.
+void write_stats( std::ostream& stream, stats_format format, const std::string& tool );
+
+// Writes a report periodically from a background thread, and once more when destroyed so the final report covers
+// the whole run. Reports go to STDERR, or replace the contents of a file so a scraper never reads a partial report.
+class stats_reporter
+{
+public:
+  stats_reporter( std::string tool, stats_format format, std::string filename, std::chrono::seconds interval );
+  ~stats_reporter();
+
+  stats_reporter( const stats_reporter& )            = delete;
+  stats_reporter& operator=( const stats_reporter& ) = delete;
+
+  void report();
+
+private:
+  std::string _tool;
+  stats_format _format;
+  std::string _filename;
+  std::chrono::seconds _interval;
+  std::mutex _mutex;
+  std::condition_variable _cv;
+  bool _stopping = false;
+  std::thread _thread;
+};
+
+// Add the --stats options shared by the tools
+void add_stats_options( boost::program_options::options_description& options );
+
+// Enable stats and start reporting if --stats was given, returns null otherwise
+std::unique_ptr< stats_reporter > make_stats_reporter( const boost::program_options::variables_map& vm,
+                                                       const std::string& tool );
+
+} // namespace koinos::tools
@@ -0,0 +1,55 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include <koinos/crypto/multihash.hpp>
+
+#include <koinos/protocol/protocol.pb.h>
+
+namespace koinos::tools {
+
+// Hash each operation of the transaction, the leaves of its operation merkle tree
+std::vector< crypto::multihash > hash_operations( const protocol::transaction& transaction );
+
+// Compute the operation merkle root from the operation hashes
+crypto::multihash operation_merkle_root( const std::vector< crypto::multihash >& operation_hashes );
+
+// True if the header commits to an operation merkle root and the id is the hash of that header,
+// as is the case for any transaction already finalized or signed by another signer
+bool is_finalized( const protocol::transaction& transaction );
+
+// Set the operation merkle root from the transaction's operations unless the transaction is already finalized.
+// Returns true if the operations were hashed.
+bool finalize_transaction( protocol::transaction& transaction );
+
+// Serialize a nonce the way the chain expects it in the transaction header
+std::string encode_nonce( uint64_t nonce );
+
+// Read a nonce from a transaction header
+uint64_t decode_nonce( const std::string& nonce );
+
+// The account whose nonce a transaction uses, its payee when one is set and its payer otherwise
+const std::string& nonce_account( const protocol::transaction& transaction );
+
+// Assigns sequential nonces to transactions per nonce account
+class nonce_tracker
+{
+public:
+  // Set the current on chain nonce of an account, its next transaction will use nonce + 1
+  void set_account_nonce( const std::string& account, uint64_t nonce );
+
+  // Load "<base58 address> <nonce>" lines with the current nonce of each account
+  void load( const std::string& filename );
+
+  // Assign the next nonce of the transaction's nonce account to a transaction without a nonce.
+  // A transaction that already has a nonce advances its account past that nonce instead.
+  void assign( protocol::transaction& transaction );
+
+private:
+  std::unordered_map< std::string, uint64_t > _next_nonce;
+};
+
+} // namespace koinos::tools
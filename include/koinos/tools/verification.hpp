@@ -0,0 +1,44 @@
+#pragma once
+
+#include <string>
+#include <unordered_set>
+#include <vector>
+
+#include <koinos/crypto/multihash.hpp>
+
+#include <koinos/protocol/protocol.pb.h>
+
+namespace koinos::tools {
+
+// What a transaction must satisfy beyond a valid id and signatures
+struct verify_options
+{
+  std::string chain_id;                      // Chain id the header must commit to, empty accepts any
+  std::unordered_set< std::string > signers; // Addresses allowed to sign, empty accepts any
+  bool require_payer = false;                // The payer, and the payee when set, must be among the signers
+};
+
+// The outcome of verifying one transaction, reused across transactions by a single thread
+struct verify_result
+{
+  std::vector< std::string > signers; // Recovered addresses in signature order
+  std::vector< std::string > errors;
+
+  bool valid() const
+  {
+    return errors.empty();
+  }
+};
+
+// Recover the address whose key produced a compact signature of the digest. Throws if the signature is malformed,
+// not canonical or does not recover a key.
+std::string recover_signer( const std::string& signature, const crypto::multihash& digest );
+
+// Check a transaction offline as the chain would before applying it: the id is the hash of the header, the header
+// commits to the operations and every signature recovers a key of an allowed signer. Every failure is reported
+// rather than only the first. Recovering a key dominates the cost, one per signature.
+void verify_transaction( const protocol::transaction& transaction,
+                         const verify_options& opts,
+                         verify_result& result );
+
+} // namespace koinos::tools
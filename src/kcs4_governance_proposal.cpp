@@ -5,7 +5,6 @@
 #include <koinos/chain/value.pb.h>
 #include <koinos/contracts/governance/governance.pb.h>
 #include <koinos/contracts/name_service/name_service.pb.h>
-#include <koinos/crypto/merkle_tree.hpp>
 #include <koinos/crypto/multihash.hpp>
 #include <koinos/log.hpp>
 #include <koinos/protocol/protocol.pb.h>
@@ -13,6 +12,8 @@
 #include <koinos/util/base64.hpp>
 #include <koinos/util/hex.hpp>
 
+#include <koinos/tools/merkle_tree.hpp>
+
 using namespace koinos;
 using namespace std::string_literals;
 
@@ -93,16 +94,8 @@ int main( int argc, char** argv, char** envp )
   proposal.set_fee( 60ull * 100'000'000ull ); // 60 KOIN
 
   // Calculate operation merkle root
-  std::vector< crypto::multihash > operations;
-  operations.reserve( proposal.operations().size() );
-
-  for( const auto& op: proposal.operations() )
-  {
-    operations.emplace_back( crypto::hash( crypto::multicodec::sha2_256, op ) );
-  }
-
-  auto operation_merkle_tree = crypto::merkle_tree( crypto::multicodec::sha2_256, operations );
-  proposal.set_operation_merkle_root( util::converter::as< std::string >( operation_merkle_tree.root()->hash() ) );
+  auto operation_merkle_tree = tools::merkle_tree::from_messages( crypto::multicodec::sha2_256, proposal.operations() );
+  proposal.set_operation_merkle_root( util::converter::as< std::string >( operation_merkle_tree.root() ) );
 
   LOG( info ) << "Proposal ID: " << util::to_hex( proposal.operation_merkle_root() );
 
@@ -122,16 +115,8 @@ int main( int argc, char** argv, char** envp )
   header->set_chain_id( util::from_base64< std::string >( "EiBncD4pKRIQWco_WRqo5Q-xnXR7JuO3PtZv983mKdKHSQ=="s ) );
   header->set_payer( payer );
 
-  operations.clear();
-  operations.reserve( trx.operations().size() );
-
-  for( const auto& op: trx.operations() )
-  {
-    operations.emplace_back( crypto::hash( crypto::multicodec::sha2_256, op ) );
-  }
-
-  operation_merkle_tree = crypto::merkle_tree( crypto::multicodec::sha2_256, operations );
-  header->set_operation_merkle_root( util::converter::as< std::string >( operation_merkle_tree.root()->hash() ) );
+  operation_merkle_tree = tools::merkle_tree::from_messages( crypto::multicodec::sha2_256, trx.operations() );
+  header->set_operation_merkle_root( util::converter::as< std::string >( operation_merkle_tree.root() ) );
   trx.set_id( util::converter::as< std::string >( crypto::hash( crypto::multicodec::sha2_256, *header ) ) );
 
   LOG( info ) << "Unsigned Transaction: " << util::to_base64( trx );
@@ -0,0 +1,52 @@
+#include <koinos/tools/block.hpp>
+
+#include <koinos/util/conversion.hpp>
+
+#include <koinos/tools/merkle_tree.hpp>
+#include <koinos/tools/stats.hpp>
+
+namespace koinos::tools {
+
+crypto::multihash transaction_merkle_root( const protocol::block& block, std::size_t num_threads )
+{
+  const auto& transactions = block.transactions();
+
+  return merkle_tree::generate(
+           crypto::multicodec::sha2_256,
+           std::size_t( transactions.size() ) * 2,
+           [ & ]( std::size_t index ) -> crypto::multihash
+           {
+             const auto& transaction = transactions.Get( int( index / 2 ) );
+
+             if( index % 2 == 0 )
+               return crypto::hash( crypto::multicodec::sha2_256, transaction.header() );
+
+             std::string signatures;
+             for( const auto& signature: transaction.signatures() )
+               signatures += signature;
+
+             return crypto::hash( crypto::multicodec::sha2_256, signatures );
+           },
+           num_threads )
+    .root();
+}
+
+crypto::multihash block_id( const protocol::block_header& header )
+{
+  stage_timer timer( stage::hash );
+  return crypto::hash( crypto::multicodec::sha2_256, header );
+}
+
+void sign_block( protocol::block& block, const crypto::private_key& signer )
+{
+  auto header = block.mutable_header();
+  header->set_signer( signer.get_public_key().to_address_bytes() );
+
+  auto id = block_id( *header );
+  block.set_id( util::converter::as< std::string >( id ) );
+
+  stage_timer timer( stage::sign );
+  block.set_signature( util::converter::as< std::string >( signer.sign_compact( id ) ) );
+}
+
+} // namespace koinos::tools
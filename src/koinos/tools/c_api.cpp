@@ -0,0 +1,292 @@
+#include <koinos/tools/c_api.h>
+
+#include <cstdlib>
+#include <cstring>
+#include <exception>
+#include <new>
+#include <stdexcept>
+#include <string>
+#include <tuple>
+#include <vector>
+
+#include <koinos/crypto/elliptic.hpp>
+#include <koinos/util/conversion.hpp>
+
+#include <koinos/protocol/protocol.pb.h>
+#include <koinos/rpc/chain/chain_rpc.pb.h>
+
+#include <koinos/tools/genesis.hpp>
+#include <koinos/tools/signing.hpp>
+#include <koinos/tools/transaction.hpp>
+
+using namespace koinos;
+
+struct koinos_tools_key
+{
+  crypto::private_key key;
+};
+
+static_assert( std::tuple_size_v< crypto::compressed_public_key > == KOINOS_TOOLS_PUBLIC_KEY_SIZE );
+
+namespace {
+
+thread_local std::string last_error;
+
+// Run a call, turning any exception into an error code so none crosses the C boundary
+template< typename Function >
+int guard( Function&& function )
+{
+  try
+  {
+    function();
+    return KOINOS_TOOLS_OK;
+  }
+  catch( const std::exception& e )
+  {
+    last_error = e.what();
+  }
+  catch( ... )
+  {
+    last_error = "unknown exception";
+  }
+
+  return KOINOS_TOOLS_ERROR;
+}
+
+void require( const void* pointer, const char* name )
+{
+  if( !pointer )
+    throw std::invalid_argument( std::string( name ) + " must not be null" );
+}
+
+// Copy bytes into a buffer the caller releases with koinos_tools_free
+void output( const std::string& bytes, uint8_t** buffer, std::size_t* size )
+{
+  require( buffer, "output buffer" );
+  require( size, "output size" );
+
+  auto data = static_cast< uint8_t* >( std::malloc( bytes.empty() ? 1 : bytes.size() ) );
+  if( !data )
+    throw std::bad_alloc();
+
+  std::memcpy( data, bytes.data(), bytes.size() );
+  *buffer = data;
+  *size   = bytes.size();
+}
+
+template< typename Message >
+void parse( const uint8_t* bytes, std::size_t size, Message& message, const char* name )
+{
+  if( size )
+    require( bytes, name );
+
+  if( !message.ParseFromArray( bytes, int( size ) ) )
+    throw std::invalid_argument( std::string( "unable to parse " ) + name );
+}
+
+template< typename Message >
+void serialize( const Message& message, uint8_t** buffer, std::size_t* size )
+{
+  output( message.SerializeAsString(), buffer, size );
+}
+
+std::string as_string( const uint8_t* bytes, std::size_t size, const char* name )
+{
+  if( size )
+    require( bytes, name );
+
+  return std::string( reinterpret_cast< const char* >( bytes ), size );
+}
+
+} // namespace
+
+extern "C" {
+
+const char* koinos_tools_last_error( void )
+{
+  return last_error.c_str();
+}
+
+void koinos_tools_free( uint8_t* buffer )
+{
+  std::free( buffer );
+}
+
+int koinos_tools_key_from_wif( const char* wif, koinos_tools_key** key )
+{
+  return guard(
+    [ & ]
+    {
+      require( wif, "wif" );
+      require( key, "key" );
+      *key = new koinos_tools_key{ crypto::private_key::from_wif( wif ) };
+    } );
+}
+
+int koinos_tools_key_from_file( const char* filename, koinos_tools_key** key )
+{
+  return guard(
+    [ & ]
+    {
+      require( filename, "filename" );
+      require( key, "key" );
+      *key = new koinos_tools_key{ tools::read_keyfile( filename ) };
+    } );
+}
+
+void koinos_tools_key_free( koinos_tools_key* key )
+{
+  delete key;
+}
+
+int koinos_tools_key_public_key( const koinos_tools_key* key, uint8_t* public_key )
+{
+  return guard(
+    [ & ]
+    {
+      require( key, "key" );
+      require( public_key, "public key" );
+
+      auto compressed = key->key.get_public_key().serialize();
+      std::memcpy( public_key, compressed.data(), KOINOS_TOOLS_PUBLIC_KEY_SIZE );
+    } );
+}
+
+int koinos_tools_sign_transaction( const uint8_t* transaction,
+                                   size_t transaction_size,
+                                   const koinos_tools_key* const* keys,
+                                   size_t key_count,
+                                   int finalize,
+                                   uint8_t** signed_transaction,
+                                   size_t* signed_transaction_size )
+{
+  return guard(
+    [ & ]
+    {
+      if( key_count )
+        require( keys, "keys" );
+
+      protocol::transaction trx;
+      parse( transaction, transaction_size, trx, "transaction" );
+
+      std::vector< crypto::private_key > signing_keys;
+      signing_keys.reserve( key_count );
+
+      for( std::size_t i = 0; i < key_count; i++ )
+      {
+        require( keys[ i ], "key" );
+        signing_keys.push_back( keys[ i ]->key );
+      }
+
+      if( finalize )
+        tools::finalize_transaction( trx );
+
+      tools::sign_transaction( trx, signing_keys );
+      serialize( trx, signed_transaction, signed_transaction_size );
+    } );
+}
+
+int koinos_tools_wrap_transaction( const uint8_t* transaction,
+                                   size_t transaction_size,
+                                   uint8_t** request,
+                                   size_t* request_size )
+{
+  return guard(
+    [ & ]
+    {
+      protocol::transaction trx;
+      parse( transaction, transaction_size, trx, "transaction" );
+
+      rpc::chain::chain_request req;
+      tools::wrap_transaction( trx, req );
+      serialize( req, request, request_size );
+    } );
+}
+
+int koinos_tools_default_genesis_data( uint8_t** genesis_data, size_t* genesis_data_size )
+{
+  return guard(
+    [ & ]
+    {
+      serialize( tools::default_genesis_data(), genesis_data, genesis_data_size );
+    } );
+}
+
+int koinos_tools_load_genesis_spec( const char* path, uint8_t** genesis_data, size_t* genesis_data_size )
+{
+  return guard(
+    [ & ]
+    {
+      require( path, "path" );
+      serialize( tools::load_genesis_spec( path ), genesis_data, genesis_data_size );
+    } );
+}
+
+int koinos_tools_generate_random_proof( const koinos_tools_key* key,
+                                        const uint8_t* input,
+                                        size_t input_size,
+                                        uint8_t** proof,
+                                        size_t* proof_size,
+                                        uint8_t** proof_hash,
+                                        size_t* proof_hash_size )
+{
+  return guard(
+    [ & ]
+    {
+      require( key, "key" );
+      require( proof_hash, "output buffer" );
+
+      auto [ vrf_proof, vrf_hash ] = key->key.generate_random_proof( as_string( input, input_size, "input" ) );
+
+      output( vrf_proof, proof, proof_size );
+
+      try
+      {
+        output( util::converter::as< std::string >( vrf_hash ), proof_hash, proof_hash_size );
+      }
+      catch( ... )
+      {
+        koinos_tools_free( *proof );
+        *proof = nullptr;
+        throw;
+      }
+    } );
+}
+
+int koinos_tools_verify_random_proof( const uint8_t* public_key,
+                                      const uint8_t* input,
+                                      size_t input_size,
+                                      const uint8_t* proof,
+                                      size_t proof_size,
+                                      const uint8_t* proof_hash,
+                                      size_t proof_hash_size,
+                                      int* valid )
+{
+  return guard(
+    [ & ]
+    {
+      require( public_key, "public key" );
+      require( valid, "valid" );
+
+      crypto::compressed_public_key compressed_key;
+      std::memcpy( compressed_key.data(), public_key, compressed_key.size() );
+      auto key = crypto::public_key::deserialize( compressed_key );
+
+      auto input_bytes = as_string( input, input_size, "input" );
+      auto proof_bytes = as_string( proof, proof_size, "proof" );
+      auto hash_bytes  = as_string( proof_hash, proof_hash_size, "proof hash" );
+
+      // The arguments are well formed from here, a proof that fails to verify is a result rather than an error
+      try
+      {
+        auto vrf_hash = key.verify_random_proof( input_bytes, proof_bytes );
+        *valid        = util::converter::as< std::string >( vrf_hash ) == hash_bytes;
+      }
+      catch( const std::exception& )
+      {
+        *valid = 0;
+      }
+    } );
+}
+
+} // extern "C"
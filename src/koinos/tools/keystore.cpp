@@ -0,0 +1,169 @@
+#include <koinos/tools/keystore.hpp>
+
+#include <algorithm>
+#include <cstring>
+#include <stdexcept>
+
+#include <koinos/crypto/multihash.hpp>
+
+#include <koinos/tools/stats.hpp>
+
+namespace koinos::tools {
+
+namespace {
+
+void append_uint( std::string& buffer, uint64_t value, std::size_t bytes )
+{
+  for( std::size_t i = 0; i < bytes; i++ )
+    buffer.push_back( char( ( value >> ( 8 * i ) ) & 0xff ) );
+}
+
+uint64_t read_uint( const char* data, std::size_t bytes )
+{
+  uint64_t value = 0;
+  for( std::size_t i = 0; i < bytes; i++ )
+    value |= uint64_t( uint8_t( data[ i ] ) ) << ( 8 * i );
+  return value;
+}
+
+std::string make_header( uint64_t count )
+{
+  std::string header( keystore_layout::magic, sizeof( keystore_layout::magic ) - 1 );
+  append_uint( header, keystore_layout::version, 4 );
+  append_uint( header, 0, 4 );
+  append_uint( header, count, 8 );
+  append_uint( header, 0, 8 );
+  return header;
+}
+
+} // namespace
+
+crypto::private_key derive_dev_key( const std::string& seed, uint64_t index )
+{
+  stage_timer timer( stage::key_load );
+  return crypto::private_key::regenerate( crypto::hash( crypto::multicodec::sha2_256, seed, index ) );
+}
+
+keystore_writer::keystore_writer( const std::filesystem::path& path ):
+    _path( path ),
+    _stream( path, std::ios::binary | std::ios::trunc )
+{
+  if( !_stream )
+    throw std::runtime_error( "unable to open keystore " + _path.string() );
+
+  _stream << make_header( 0 );
+}
+
+void keystore_writer::add( const crypto::private_key& key, std::string address )
+{
+  if( address.size() != keystore_layout::address_size )
+    throw std::runtime_error( "unexpected address size " + std::to_string( address.size() ) );
+
+  auto secret = key.get_secret();
+  _stream.write( reinterpret_cast< const char* >( secret.data() ), secret.size() );
+  _index.emplace_back( std::move( address ), _index.size() );
+}
+
+void keystore_writer::close()
+{
+  std::sort( _index.begin(), _index.end() );
+
+  std::string entry;
+  for( const auto& [ address, index ]: _index )
+  {
+    entry = address;
+    entry.resize( keystore_layout::index_entry_size - 8, '\0' );
+    append_uint( entry, index, 8 );
+    _stream << entry;
+  }
+
+  _stream.seekp( 0 );
+  _stream << make_header( _index.size() );
+  _stream.close();
+
+  if( !_stream )
+    throw std::runtime_error( "error writing keystore " + _path.string() );
+}
+
+uint64_t keystore_writer::size() const
+{
+  return _index.size();
+}
+
+keystore::keystore( const std::filesystem::path& path ):
+    _path( path ),
+    _stream( path, std::ios::binary )
+{
+  if( !_stream )
+    throw std::runtime_error( "unable to open keystore " + _path.string() );
+
+  auto header = read( 0, keystore_layout::header_size );
+  if( header.compare( 0, sizeof( keystore_layout::magic ) - 1, keystore_layout::magic ) != 0 )
+    throw std::runtime_error( _path.string() + " is not a keystore" );
+
+  if( auto version = read_uint( header.data() + 8, 4 ); version != keystore_layout::version )
+    throw std::runtime_error( "unsupported keystore version " + std::to_string( version ) );
+
+  _size = read_uint( header.data() + 16, 8 );
+
+  auto expected_size =
+    keystore_layout::header_size + _size * ( keystore_layout::secret_size + keystore_layout::index_entry_size );
+  if( std::filesystem::file_size( _path ) != expected_size )
+    throw std::runtime_error( "keystore " + _path.string() + " is truncated or corrupt" );
+}
+
+uint64_t keystore::size() const
+{
+  return _size;
+}
+
+crypto::private_key keystore::at( uint64_t index )
+{
+  if( index >= _size )
+    throw std::out_of_range( "keystore index " + std::to_string( index ) + " out of range" );
+
+  stage_timer timer( stage::key_load );
+
+  auto secret = read( keystore_layout::header_size + index * keystore_layout::secret_size,
+                      keystore_layout::secret_size );
+
+  crypto::digest_type digest( secret.size() );
+  std::memcpy( digest.data(), secret.data(), secret.size() );
+  return crypto::private_key::regenerate( crypto::multihash( crypto::multicodec::sha2_256, std::move( digest ) ) );
+}
+
+std::optional< uint64_t > keystore::find( const std::string& address )
+{
+  const uint64_t index_offset = keystore_layout::header_size + _size * keystore_layout::secret_size;
+
+  uint64_t low = 0, high = _size;
+  while( low < high )
+  {
+    auto mid   = low + ( high - low ) / 2;
+    auto entry = read( index_offset + mid * keystore_layout::index_entry_size, keystore_layout::index_entry_size );
+    auto cmp   = entry.compare( 0, keystore_layout::address_size, address );
+
+    if( cmp == 0 )
+      return read_uint( entry.data() + keystore_layout::index_entry_size - 8, 8 );
+    else if( cmp < 0 )
+      low = mid + 1;
+    else
+      high = mid;
+  }
+
+  return {};
+}
+
+std::string keystore::read( uint64_t offset, std::size_t size )
+{
+  std::string buffer( size, '\0' );
+  _stream.seekg( offset );
+  _stream.read( buffer.data(), size );
+
+  if( !_stream )
+    throw std::runtime_error( "error reading keystore " + _path.string() );
+
+  return buffer;
+}
+
+} // namespace koinos::tools
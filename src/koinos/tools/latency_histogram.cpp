@@ -0,0 +1,112 @@
+#include <koinos/tools/latency_histogram.hpp>
+
+#include <algorithm>
+#include <bit>
+#include <cmath>
+
+namespace koinos::tools {
+
+std::size_t latency_histogram::bucket_index( uint64_t value )
+{
+  if( value < sub_bucket_count )
+    return value;
+
+  std::size_t shift = std::bit_width( value ) - 1 - sub_bucket_bits;
+  std::size_t sub   = ( value >> shift ) - sub_bucket_count;
+  return ( shift + 1 ) * sub_bucket_count + sub;
+}
+
+uint64_t latency_histogram::bucket_midpoint( std::size_t index )
+{
+  if( index < sub_bucket_count )
+    return index;
+
+  std::size_t shift = index / sub_bucket_count - 1;
+  uint64_t lower    = uint64_t( sub_bucket_count + index % sub_bucket_count ) << shift;
+  return lower + ( ( uint64_t( 1 ) << shift ) >> 1 );
+}
+
+void latency_histogram::record( std::chrono::nanoseconds duration )
+{
+  uint64_t value = duration.count() > 0 ? uint64_t( duration.count() ) : 0;
+
+  _buckets[ bucket_index( value ) ].fetch_add( 1, std::memory_order_relaxed );
+  _count.fetch_add( 1, std::memory_order_relaxed );
+  _total.fetch_add( value, std::memory_order_relaxed );
+
+  auto current_max = _max.load( std::memory_order_relaxed );
+  while( value > current_max && !_max.compare_exchange_weak( current_max, value, std::memory_order_relaxed ) )
+    ;
+}
+
+void latency_histogram::merge( const latency_histogram& other )
+{
+  for( std::size_t i = 0; i < bucket_count; i++ )
+    _buckets[ i ].fetch_add( other._buckets[ i ].load( std::memory_order_relaxed ), std::memory_order_relaxed );
+
+  _count.fetch_add( other.count(), std::memory_order_relaxed );
+  _total.fetch_add( other._total.load( std::memory_order_relaxed ), std::memory_order_relaxed );
+
+  auto other_max   = other._max.load( std::memory_order_relaxed );
+  auto current_max = _max.load( std::memory_order_relaxed );
+  while( other_max > current_max && !_max.compare_exchange_weak( current_max, other_max, std::memory_order_relaxed ) )
+    ;
+}
+
+void latency_histogram::reset()
+{
+  for( auto& bucket: _buckets )
+    bucket.store( 0, std::memory_order_relaxed );
+
+  _count.store( 0, std::memory_order_relaxed );
+  _total.store( 0, std::memory_order_relaxed );
+  _max.store( 0, std::memory_order_relaxed );
+}
+
+uint64_t latency_histogram::count() const
+{
+  return _count.load( std::memory_order_relaxed );
+}
+
+std::chrono::nanoseconds latency_histogram::total() const
+{
+  return std::chrono::nanoseconds( _total.load( std::memory_order_relaxed ) );
+}
+
+std::chrono::nanoseconds latency_histogram::max() const
+{
+  return std::chrono::nanoseconds( _max.load( std::memory_order_relaxed ) );
+}
+
+std::chrono::nanoseconds latency_histogram::mean() const
+{
+  auto samples = count();
+  return std::chrono::nanoseconds( samples ? total().count() / int64_t( samples ) : 0 );
+}
+
+std::chrono::nanoseconds latency_histogram::percentile( double fraction ) const
+{
+  uint64_t samples = 0;
+
+  for( const auto& bucket: _buckets )
+    samples += bucket.load( std::memory_order_relaxed );
+
+  if( !samples )
+    return std::chrono::nanoseconds( 0 );
+
+  auto rank       = std::max< uint64_t >( uint64_t( std::ceil( fraction * samples ) ), 1 );
+  uint64_t seen   = 0;
+  auto max_sample = max();
+
+  for( std::size_t i = 0; i < bucket_count; i++ )
+  {
+    seen += _buckets[ i ].load( std::memory_order_relaxed );
+
+    if( seen >= rank )
+      return std::min( std::chrono::nanoseconds( bucket_midpoint( i ) ), max_sample );
+  }
+
+  return max_sample;
+}
+
+} // namespace koinos::tools
@@ -0,0 +1,299 @@
+#include <koinos/tools/merkle_tree.hpp>
+
+#include <algorithm>
+#include <exception>
+#include <stdexcept>
+#include <string>
+#include <thread>
+
+#include <koinos/tools/stats.hpp>
+
+namespace koinos::tools {
+
+namespace {
+
+// Below this many nodes per thread, starting threads costs more than it saves
+const std::size_t MIN_NODES_PER_THREAD = 1'024;
+
+// Run work over [ 0, count ) split into contiguous ranges across up to num_threads threads
+void parallel_for( std::size_t count,
+                   std::size_t num_threads,
+                   const std::function< void( std::size_t, std::size_t ) >& work )
+{
+  num_threads = std::min( num_threads, count / MIN_NODES_PER_THREAD );
+
+  if( num_threads <= 1 )
+  {
+    work( 0, count );
+    return;
+  }
+
+  std::vector< std::thread > threads;
+  std::vector< std::exception_ptr > errors( num_threads );
+  threads.reserve( num_threads );
+
+  auto chunk = ( count + num_threads - 1 ) / num_threads;
+
+  for( std::size_t t = 0; t < num_threads; t++ )
+  {
+    threads.emplace_back(
+      [ &, t ]()
+      {
+        try
+        {
+          work( std::min( t * chunk, count ), std::min( ( t + 1 ) * chunk, count ) );
+        }
+        catch( ... )
+        {
+          errors[ t ] = std::current_exception();
+        }
+      } );
+  }
+
+  for( auto& thread: threads )
+    thread.join();
+
+  for( auto& error: errors )
+  {
+    if( error )
+      std::rethrow_exception( error );
+  }
+}
+
+crypto::multihash combine_digests( crypto::multicodec code, const std::byte* digests, std::size_t digest_size )
+{
+  return crypto::hash( code, reinterpret_cast< const char* >( digests ), 2 * digest_size );
+}
+
+} // namespace
+
+merkle_tree::merkle_tree( crypto::multicodec code ):
+    _code( code )
+{}
+
+merkle_tree::merkle_tree( crypto::multicodec code,
+                          const std::vector< crypto::multihash >& leaves,
+                          std::size_t num_threads ):
+    _code( code )
+{
+  build( leaves.size(),
+         num_threads,
+         [ & ]( std::size_t index )
+         {
+           return leaves[ index ];
+         } );
+}
+
+merkle_tree merkle_tree::generate( crypto::multicodec code,
+                                  std::size_t count,
+                                  const std::function< crypto::multihash( std::size_t ) >& leaf,
+                                  std::size_t num_threads )
+{
+  merkle_tree tree( code );
+  tree.build( count, num_threads, leaf );
+  return tree;
+}
+
+void merkle_tree::build( std::size_t count,
+                         std::size_t num_threads,
+                         const std::function< crypto::multihash( std::size_t ) >& leaf )
+{
+  stage_timer timer( stage::hash );
+
+  _levels.clear();
+  _digest_size = 0;
+
+  if( !count )
+    return;
+
+  // The first leaf fixes the digest size of every node
+  auto first   = leaf( 0 );
+  _digest_size = first.digest().size();
+
+  _levels.emplace_back( count * _digest_size );
+  set_leaf( 0, first );
+
+  parallel_for( count - 1,
+                num_threads,
+                [ & ]( std::size_t begin, std::size_t end )
+                {
+                  for( auto index = begin + 1; index < end + 1; index++ )
+                    set_leaf( index, leaf( index ) );
+                } );
+
+  // Build each level from the one below it, every parent depends only on its own two children
+  for( std::size_t level = 0; _levels[ level ].size() > _digest_size; level++ )
+  {
+    auto parents = ( _levels[ level ].size() / _digest_size + 1 ) / 2;
+    _levels.emplace_back( parents * _digest_size );
+
+    parallel_for( parents,
+                  num_threads,
+                  [ & ]( std::size_t begin, std::size_t end )
+                  {
+                    for( auto index = begin; index < end; index++ )
+                      combine( level, index );
+                  } );
+  }
+}
+
+std::size_t merkle_tree::size() const
+{
+  return _levels.empty() ? 0 : _levels.front().size() / _digest_size;
+}
+
+crypto::multihash merkle_tree::root() const
+{
+  if( _levels.empty() )
+    return crypto::multihash::empty( _code );
+
+  return node( _levels.size() - 1, 0 );
+}
+
+crypto::multihash merkle_tree::leaf( std::size_t index ) const
+{
+  if( index >= size() )
+    throw std::out_of_range( "merkle leaf " + std::to_string( index ) + " out of range" );
+
+  return node( 0, index );
+}
+
+void merkle_tree::append( const crypto::multihash& leaf )
+{
+  if( _levels.empty() )
+  {
+    _digest_size = leaf.digest().size();
+    _levels.emplace_back();
+  }
+
+  auto index = size();
+  _levels.front().resize( ( index + 1 ) * _digest_size );
+  set_leaf( index, leaf );
+  update_path( index );
+}
+
+void merkle_tree::replace( std::size_t index, const crypto::multihash& leaf )
+{
+  if( index >= size() )
+    throw std::out_of_range( "merkle leaf " + std::to_string( index ) + " out of range" );
+
+  set_leaf( index, leaf );
+  update_path( index );
+}
+
+merkle_proof merkle_tree::proof( std::size_t index ) const
+{
+  if( index >= size() )
+    throw std::out_of_range( "merkle leaf " + std::to_string( index ) + " out of range" );
+
+  merkle_proof result;
+  result.index  = index;
+  result.leaves = size();
+
+  for( std::size_t level = 0; level + 1 < _levels.size(); level++ )
+  {
+    auto sibling = index ^ 1;
+    if( sibling < _levels[ level ].size() / _digest_size )
+      result.siblings.push_back( node( level, sibling ) );
+
+    index /= 2;
+  }
+
+  return result;
+}
+
+void merkle_tree::set_leaf( std::size_t index, const crypto::multihash& leaf )
+{
+  const auto& digest = leaf.digest();
+  if( digest.size() != _digest_size )
+    throw std::invalid_argument( "merkle leaf digest size " + std::to_string( digest.size() ) + " does not match "
+                                 + std::to_string( _digest_size ) );
+
+  std::copy( digest.begin(), digest.end(), _levels.front().begin() + index * _digest_size );
+}
+
+void merkle_tree::update_path( std::size_t index )
+{
+  for( std::size_t level = 0; _levels[ level ].size() > _digest_size; level++ )
+  {
+    auto parents = ( _levels[ level ].size() / _digest_size + 1 ) / 2;
+
+    if( level + 1 == _levels.size() )
+      _levels.emplace_back();
+
+    _levels[ level + 1 ].resize( parents * _digest_size );
+
+    index /= 2;
+    combine( level, index );
+  }
+}
+
+void merkle_tree::combine( std::size_t level, std::size_t index )
+{
+  const auto& children = _levels[ level ];
+  auto& parent         = _levels[ level + 1 ];
+
+  auto left = children.data() + 2 * index * _digest_size;
+
+  // The last node of an odd sized level moves up unchanged
+  if( 2 * index + 1 == children.size() / _digest_size )
+  {
+    std::copy( left, left + _digest_size, parent.begin() + index * _digest_size );
+    return;
+  }
+
+  auto hash = combine_digests( _code, left, _digest_size );
+  std::copy( hash.digest().begin(), hash.digest().end(), parent.begin() + index * _digest_size );
+}
+
+crypto::multihash merkle_tree::node( std::size_t level, std::size_t index ) const
+{
+  auto begin = _levels[ level ].begin() + index * _digest_size;
+  return crypto::multihash( _code, crypto::digest_type( begin, begin + _digest_size ) );
+}
+
+bool verify_merkle_proof( crypto::multicodec code,
+                          const crypto::multihash& leaf,
+                          const merkle_proof& proof,
+                          const crypto::multihash& root )
+{
+  if( proof.index >= proof.leaves )
+    return false;
+
+  auto current = leaf.digest();
+  auto index   = proof.index;
+  auto count   = proof.leaves;
+  auto sibling = proof.siblings.begin();
+
+  std::vector< std::byte > pair;
+
+  while( count > 1 )
+  {
+    if( ( index ^ 1 ) < count )
+    {
+      if( sibling == proof.siblings.end() || sibling->digest().size() != current.size() )
+        return false;
+
+      const auto& other = sibling->digest();
+      pair.clear();
+
+      if( index % 2 )
+        pair.insert( pair.end(), other.begin(), other.end() );
+
+      pair.insert( pair.end(), current.begin(), current.end() );
+
+      if( index % 2 == 0 )
+        pair.insert( pair.end(), other.begin(), other.end() );
+
+      current = combine_digests( code, pair.data(), current.size() ).digest();
+      sibling++;
+    }
+
+    index /= 2;
+    count = ( count + 1 ) / 2;
+  }
+
+  return sibling == proof.siblings.end() && current == root.digest();
+}
+
+} // namespace koinos::tools
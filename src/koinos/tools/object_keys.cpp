@@ -0,0 +1,97 @@
+#include <koinos/tools/object_keys.hpp>
+
+#include <cstring>
+#include <unordered_map>
+
+#include <koinos/crypto/multihash.hpp>
+#include <koinos/util/conversion.hpp>
+
+namespace koinos::tools {
+
+namespace {
+
+// Keys are encoded multihashes, built once from the compile time digests
+const std::array< std::string, kernel_object_names.size() >& kernel_object_keys()
+{
+  static const auto keys = []()
+  {
+    std::array< std::string, kernel_object_names.size() > keys;
+    for( std::size_t i = 0; i < keys.size(); i++ )
+    {
+      crypto::digest_type digest( kernel_object_digests[ i ].size() );
+      std::memcpy( digest.data(), kernel_object_digests[ i ].data(), digest.size() );
+      keys[ i ] = util::converter::as< std::string >( crypto::multihash( crypto::multicodec::sha2_256, digest ) );
+    }
+    return keys;
+  }();
+
+  return keys;
+}
+
+const std::unordered_map< std::string, kernel_object >& kernel_objects_by_key()
+{
+  static const auto objects = []()
+  {
+    std::unordered_map< std::string, kernel_object > objects;
+    for( std::size_t i = 0; i < kernel_object_names.size(); i++ )
+      objects.emplace( kernel_object_keys()[ i ], kernel_object( i ) );
+    return objects;
+  }();
+
+  return objects;
+}
+
+} // namespace
+
+const std::string& object_key( kernel_object object )
+{
+  return kernel_object_keys()[ std::size_t( object ) ];
+}
+
+std::string object_key( const std::string& name )
+{
+  if( auto object = find_kernel_object( name ) )
+    return object_key( *object );
+
+  return util::converter::as< std::string >(
+    crypto::hash( crypto::multicodec::sha2_256, std::string( object_key_prefix ) + name ) );
+}
+
+std::optional< kernel_object > find_kernel_object( std::string_view name )
+{
+  for( std::size_t i = 0; i < kernel_object_names.size(); i++ )
+  {
+    if( kernel_object_names[ i ] == name )
+      return kernel_object( i );
+  }
+
+  return {};
+}
+
+std::optional< kernel_object > find_kernel_object_by_key( const std::string& key )
+{
+  const auto& objects = kernel_objects_by_key();
+  if( auto itr = objects.find( key ); itr != objects.end() )
+    return itr->second;
+
+  return {};
+}
+
+chain::object_space system_space( chain::system_space_id id )
+{
+  chain::object_space space;
+  space.set_system( true );
+  space.set_zone( std::string{} );
+  space.set_id( id );
+  return space;
+}
+
+std::string space_name( const chain::object_space& space )
+{
+  if( !space.system() || !space.zone().empty() || !chain::system_space_id_IsValid( space.id() ) )
+    return {};
+
+  return chain::system_space_id_Name( chain::system_space_id( space.id() ) );
+}
+
+} // namespace koinos::tools
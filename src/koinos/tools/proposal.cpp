@@ -0,0 +1,181 @@
+#include <koinos/tools/proposal.hpp>
+
+#include "yaml_spec.hpp"
+
+#include <stdexcept>
+
+#include <yaml-cpp/yaml.h>
+
+#include <koinos/crypto/multihash.hpp>
+#include <koinos/util/base58.hpp>
+#include <koinos/util/conversion.hpp>
+
+#include <koinos/chain/system_call_ids.pb.h>
+#include <koinos/contracts/governance/governance.pb.h>
+
+#include <koinos/tools/merkle_tree.hpp>
+#include <koinos/tools/transaction.hpp>
+
+namespace koinos::tools {
+
+namespace {
+
+const YAML::Node& require( const YAML::Node& node, const std::string& field, const YAML::Node& parent )
+{
+  if( !node )
+    throw std::runtime_error( "missing " + field + " at " + spec::describe( parent ) );
+
+  return node;
+}
+
+std::string parse_address( const YAML::Node& node, const std::filesystem::path& base_dir )
+{
+  if( node.IsScalar() )
+    return util::from_base58< std::string >( node.as< std::string >() );
+
+  return spec::parse_bytes( node, base_dir );
+}
+
+// Integers are decimal, or hexadecimal with a 0x prefix as entry points are usually written
+uint64_t parse_integer( const YAML::Node& node )
+{
+  const auto& scalar = node.Scalar();
+
+  std::size_t parsed = 0;
+  uint64_t value     = 0;
+
+  try
+  {
+    value = std::stoull( scalar, &parsed, 0 );
+  }
+  catch( const std::exception& )
+  {}
+
+  if( scalar.empty() || parsed != scalar.size() || scalar[ 0 ] == '-' )
+    throw std::runtime_error( "expected an integer at " + spec::describe( node ) );
+
+  return value;
+}
+
+uint32_t parse_call_id( const YAML::Node& node )
+{
+  chain::system_call_id id;
+  if( chain::system_call_id_Parse( node.as< std::string >(), &id ) )
+    return id;
+
+  return uint32_t( parse_integer( node ) );
+}
+
+void parse_operation( const YAML::Node& node, const std::filesystem::path& base_dir, protocol::operation& op )
+{
+  if( !node.IsMap() || node.size() != 1 )
+    throw std::runtime_error( "expected a single operation at " + spec::describe( node ) );
+
+  auto type   = node.begin()->first.as< std::string >();
+  auto fields = node.begin()->second;
+
+  if( type == "set_system_contract" )
+  {
+    auto set_system_contract = op.mutable_set_system_contract();
+    set_system_contract->set_contract_id(
+      parse_address( require( fields[ "contract_id" ], "contract_id", fields ), base_dir ) );
+    set_system_contract->set_system_contract(
+      require( fields[ "system_contract" ], "system_contract", fields ).as< bool >() );
+  }
+  else if( type == "set_system_call" )
+  {
+    auto set_system_call = op.mutable_set_system_call();
+    set_system_call->set_call_id( parse_call_id( require( fields[ "call_id" ], "call_id", fields ) ) );
+
+    if( fields[ "thunk_id" ] )
+    {
+      set_system_call->mutable_target()->set_thunk_id( uint32_t( parse_integer( fields[ "thunk_id" ] ) ) );
+    }
+    else
+    {
+      auto bundle = set_system_call->mutable_target()->mutable_system_call_bundle();
+      bundle->set_contract_id( parse_address( require( fields[ "contract_id" ], "contract_id", fields ), base_dir ) );
+      bundle->set_entry_point( uint32_t( parse_integer( require( fields[ "entry_point" ], "entry_point", fields ) ) ) );
+    }
+  }
+  else if( type == "call_contract" )
+  {
+    auto call_contract = op.mutable_call_contract();
+    call_contract->set_contract_id(
+      parse_address( require( fields[ "contract_id" ], "contract_id", fields ), base_dir ) );
+    call_contract->set_entry_point(
+      uint32_t( parse_integer( require( fields[ "entry_point" ], "entry_point", fields ) ) ) );
+
+    if( fields[ "args" ] )
+      call_contract->set_args( spec::parse_bytes( fields[ "args" ], base_dir ) );
+  }
+  else
+  {
+    throw std::runtime_error( "unknown operation '" + type + "' at " + spec::describe( node ) );
+  }
+}
+
+} // namespace
+
+proposal load_proposal_spec( const std::filesystem::path& path )
+{
+  auto document = YAML::LoadFile( path.string() );
+  auto base_dir = path.parent_path();
+
+  if( !document[ "operations" ] || !document[ "operations" ].IsSequence() )
+    throw std::runtime_error( "proposal " + path.string() + " has no operations list" );
+
+  proposal result;
+  auto& transaction = result.transaction;
+
+  try
+  {
+    google::protobuf::RepeatedPtrField< protocol::operation > operations;
+    for( const auto& node: document[ "operations" ] )
+      parse_operation( node, base_dir, *operations.Add() );
+
+    if( document[ "governance" ] )
+    {
+      contracts::governance::submit_proposal_arguments arguments;
+      *arguments.mutable_operations() = operations;
+
+      if( document[ "fee" ] )
+        arguments.set_fee( parse_integer( document[ "fee" ] ) );
+
+      auto tree = merkle_tree::from_messages( crypto::multicodec::sha2_256, arguments.operations() );
+      result.id = util::converter::as< std::string >( tree.root() );
+      arguments.set_operation_merkle_root( result.id );
+
+      auto call_contract = transaction.add_operations()->mutable_call_contract();
+      call_contract->set_contract_id( parse_address( document[ "governance" ], base_dir ) );
+      call_contract->set_entry_point( document[ "entry_point" ] ? uint32_t( parse_integer( document[ "entry_point" ] ) )
+                                                                : SUBMIT_PROPOSAL_ENTRY_POINT );
+      call_contract->set_args( util::converter::as< std::string >( arguments ) );
+    }
+    else
+    {
+      *transaction.mutable_operations() = operations;
+    }
+
+    auto header = transaction.mutable_header();
+    header->set_chain_id( spec::parse_bytes( require( document[ "chain_id" ], "chain_id", document ), base_dir ) );
+    header->set_payer( parse_address( require( document[ "payer" ], "payer", document ), base_dir ) );
+    header->set_nonce( encode_nonce( parse_integer( require( document[ "nonce" ], "nonce", document ) ) ) );
+    header->set_rc_limit( parse_integer( require( document[ "rc_limit" ], "rc_limit", document ) ) );
+
+    if( document[ "payee" ] )
+      header->set_payee( parse_address( document[ "payee" ], base_dir ) );
+  }
+  catch( const YAML::Exception& e )
+  {
+    throw std::runtime_error( "invalid proposal " + path.string() + ": " + e.what() );
+  }
+
+  finalize_transaction( transaction );
+  transaction.set_id(
+    util::converter::as< std::string >( crypto::hash( crypto::multicodec::sha2_256, transaction.header() ) ) );
+
+  return result;
+}
+
+} // namespace koinos::tools
@@ -0,0 +1,316 @@
+#include <koinos/tools/records.hpp>
+
+#include <algorithm>
+#include <cstring>
+#include <stdexcept>
+#include <system_error>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <google/protobuf/io/coded_stream.h>
+#include <google/protobuf/io/zero_copy_stream_impl_lite.h>
+#include <google/protobuf/util/delimited_message_util.h>
+
+#include <koinos/util/base64.hpp>
+
+#include <koinos/tools/stats.hpp>
+
+namespace koinos::tools {
+
+record_format parse_record_format( const std::string& name )
+{
+  if( name == "json" )
+    return record_format::json;
+  if( name == "compact" )
+    return record_format::compact;
+  if( name == "binary" )
+    return record_format::binary;
+  if( name == "base64" )
+    return record_format::base64;
+
+  throw std::invalid_argument( "unknown record format '" + name + "', expected json, compact, binary or base64" );
+}
+
+record_options make_record_options( record_format input, record_format output )
+{
+  record_options opts;
+  opts.input  = input;
+  opts.output = output;
+
+  opts.json_opts.ignore_unknown_fields         = true;
+  opts.json_opts.case_insensitive_enum_parsing = true;
+
+  // Newline delimited output requires each record on a single line
+  opts.print_options.add_whitespace                = output == record_format::json;
+  opts.print_options.always_print_primitive_fields = true;
+  opts.print_options.preserve_proto_field_names    = true;
+
+  return opts;
+}
+
+record_reader::record_reader( record_format format, std::istream& stream ):
+    _format( format ),
+    _stream( stream )
+{}
+
+bool record_reader::next( std::string& record )
+{
+  record.clear();
+
+  if( _format != record_format::binary )
+  {
+    // Skip blank lines between text records
+    while( std::getline( _stream, record ) )
+    {
+      _position++;
+
+      if( !record.empty() )
+        return true;
+    }
+
+    return false;
+  }
+
+  // Reading through the stream buffer rather than a buffering protobuf stream keeps caught_up() exact
+  auto buffer   = _stream.rdbuf();
+  uint32_t size = 0;
+
+  for( int shift = 0;; shift += 7 )
+  {
+    auto byte = buffer->sbumpc();
+
+    if( byte == std::char_traits< char >::eof() )
+    {
+      if( shift )
+        throw std::runtime_error( "truncated record length after record " + std::to_string( _position ) );
+
+      return false;
+    }
+
+    if( shift > 28 )
+      throw std::runtime_error( "invalid record length after record " + std::to_string( _position ) );
+
+    size |= uint32_t( byte & 0x7f ) << shift;
+
+    if( !( byte & 0x80 ) )
+      break;
+  }
+
+  record.resize( size );
+
+  if( buffer->sgetn( record.data(), size ) != std::streamsize( size ) )
+    throw std::runtime_error( "truncated record " + std::to_string( _position + 1 ) );
+
+  _position++;
+  return true;
+}
+
+uint64_t record_reader::position() const
+{
+  return _position;
+}
+
+bool record_reader::caught_up() const
+{
+  return _stream.rdbuf()->in_avail() <= 0;
+}
+
+void output_flusher::record_read( bool caught_up )
+{
+  _read++;
+
+  if( caught_up )
+    _flush_through.store( _read, std::memory_order_release );
+}
+
+bool output_flusher::record_written()
+{
+  return ++_written <= _flush_through.load( std::memory_order_acquire );
+}
+
+namespace {
+
+// Read a record length prefix at offset, returning the offset of the record itself
+uint64_t read_length( const char* data, std::size_t size, uint64_t offset, uint32_t& length )
+{
+  google::protobuf::io::CodedInputStream coded_input( reinterpret_cast< const uint8_t* >( data + offset ),
+                                                      int( std::min< uint64_t >( size - offset, INT32_MAX ) ) );
+
+  if( !coded_input.ReadVarint32( &length ) )
+    throw std::runtime_error( "truncated record length at offset " + std::to_string( offset ) );
+
+  return offset + coded_input.CurrentPosition();
+}
+
+} // namespace
+
+mapped_records::mapped_records( const std::string& filename, record_format format ):
+    _format( format )
+{
+  int fd = ::open( filename.c_str(), O_RDONLY );
+  if( fd < 0 )
+    throw std::system_error( errno, std::generic_category(), "unable to open " + filename );
+
+  struct stat info;
+  if( ::fstat( fd, &info ) < 0 )
+  {
+    auto error = errno;
+    ::close( fd );
+    throw std::system_error( error, std::generic_category(), "unable to stat " + filename );
+  }
+
+  _size = std::size_t( info.st_size );
+
+  if( _size )
+  {
+    auto data = ::mmap( nullptr, _size, PROT_READ, MAP_PRIVATE, fd, 0 );
+    if( data == MAP_FAILED )
+    {
+      auto error = errno;
+      ::close( fd );
+      throw std::system_error( error, std::generic_category(), "unable to map " + filename );
+    }
+
+    _data = static_cast< const char* >( data );
+    ::madvise( data, _size, MADV_SEQUENTIAL );
+  }
+
+  // The mapping stays valid once the descriptor is closed
+  ::close( fd );
+
+  try
+  {
+    uint64_t offset = 0;
+
+    while( offset < _size )
+    {
+      if( _format == record_format::binary )
+      {
+        uint32_t length;
+        auto start = read_length( _data, _size, offset, length );
+
+        if( start + length > _size )
+          throw std::runtime_error( "truncated record " + std::to_string( _offsets.size() + 1 ) );
+
+        _offsets.push_back( offset );
+        offset = start + length;
+      }
+      else
+      {
+        auto end = static_cast< const char* >( std::memchr( _data + offset, '\n', _size - offset ) );
+        auto next = end ? uint64_t( end - _data ) + 1 : _size;
+
+        // Skip blank lines between text records
+        if( next - offset > ( end ? 1 : 0 ) )
+          _offsets.push_back( offset );
+
+        offset = next;
+      }
+    }
+  }
+  catch( ... )
+  {
+    if( _data )
+      ::munmap( const_cast< char* >( _data ), _size );
+    throw;
+  }
+}
+
+mapped_records::~mapped_records()
+{
+  if( _data )
+    ::munmap( const_cast< char* >( _data ), _size );
+}
+
+std::size_t mapped_records::size() const
+{
+  return _offsets.size();
+}
+
+uint64_t mapped_records::file_size() const
+{
+  return _size;
+}
+
+std::string_view mapped_records::contents() const
+{
+  return std::string_view( _data ? _data : "", _size );
+}
+
+std::string_view mapped_records::record( std::size_t index ) const
+{
+  auto offset = _offsets.at( index );
+
+  if( _format == record_format::binary )
+  {
+    uint32_t length;
+    auto start = read_length( _data, _size, offset, length );
+    return std::string_view( _data + start, length );
+  }
+
+  auto end = static_cast< const char* >( std::memchr( _data + offset, '\n', _size - offset ) );
+  return std::string_view( _data + offset, ( end ? end : _data + _size ) - ( _data + offset ) );
+}
+
+void parse_record( const std::string& record, const record_options& opts, google::protobuf::Message& message )
+{
+  stage_timer timer( stage::parse );
+  add_stage_bytes( stage::parse, record.size() );
+
+  switch( opts.input )
+  {
+    case record_format::json:
+    case record_format::compact:
+      {
+        auto status = google::protobuf::util::JsonStringToMessage( record, &message, opts.json_opts );
+        if( !status.ok() )
+          throw std::runtime_error( std::string( status.message() ) );
+        break;
+      }
+    case record_format::binary:
+      if( !message.ParseFromString( record ) )
+        throw std::runtime_error( "unable to parse " + message.GetTypeName() );
+      break;
+    case record_format::base64:
+      if( !message.ParseFromString( util::from_base64< std::string >( record ) ) )
+        throw std::runtime_error( "unable to parse " + message.GetTypeName() );
+      break;
+  }
+}
+
+void serialize_record( const google::protobuf::Message& message, const record_options& opts, std::string& record )
+{
+  stage_timer timer( stage::serialize );
+  record.clear();
+
+  switch( opts.output )
+  {
+    case record_format::json:
+    case record_format::compact:
+      google::protobuf::util::MessageToJsonString( message, &record, opts.print_options );
+      record.push_back( '\n' );
+      break;
+    case record_format::binary:
+      if( opts.delimited )
+      {
+        google::protobuf::io::StringOutputStream output( &record );
+        google::protobuf::util::SerializeDelimitedToZeroCopyStream( message, &output );
+      }
+      else
+      {
+        message.SerializeToString( &record );
+      }
+      break;
+    case record_format::base64:
+      record = util::to_base64< std::string >( message.SerializeAsString() );
+      record.push_back( '\n' );
+      break;
+  }
+
+  add_stage_bytes( stage::serialize, record.size() );
+}
+
+} // namespace koinos::tools
@@ -0,0 +1,196 @@
+#include <koinos/tools/resources.hpp>
+
+#include <cmath>
+#include <optional>
+#include <unordered_map>
+
+#include <google/protobuf/io/coded_stream.h>
+
+#include <koinos/util/conversion.hpp>
+
+#include <koinos/tools/object_keys.hpp>
+
+namespace koinos::tools {
+
+namespace {
+
+// Serialized sizes of the fields a transaction gains when finalized and signed
+const std::size_t MULTIHASH_SIZE  = 34; // sha2_256 code, digest size and 32 byte digest
+const std::size_t SIGNATURE_SIZE  = 65;
+const std::size_t MAX_VARINT_SIZE = 10;
+
+// The size of a length delimited field holding size bytes, including its tag
+std::size_t field_size( std::size_t size )
+{
+  return 1 + google::protobuf::io::CodedOutputStream::VarintSize64( size ) + size;
+}
+
+// The resource limits and registry found in genesis entries
+struct genesis_resources
+{
+  std::optional< chain::resource_limit_data > limits;
+  std::optional< chain::compute_bandwidth_registry > registry;
+
+  void add( const chain::genesis_entry& entry )
+  {
+    if( entry.key() == object_key( kernel_object::resource_limit_data ) )
+      limits = util::converter::to< chain::resource_limit_data >( entry.value() );
+    else if( entry.key() == object_key( kernel_object::compute_bandwidth_registry ) )
+      registry = util::converter::to< chain::compute_bandwidth_registry >( entry.value() );
+  }
+
+  // An estimator for the entries found, with the defaults for those missing
+  rc_estimator estimator() const
+  {
+    return rc_estimator( limits ? *limits : default_resource_limit_data(),
+                         registry ? *registry : default_compute_bandwidth_registry() );
+  }
+};
+
+} // namespace
+
+rc_estimator::rc_estimator( const chain::resource_limit_data& limits,
+                            const chain::compute_bandwidth_registry& registry ):
+    _limits( limits )
+{
+  std::unordered_map< std::string, uint64_t > compute;
+  for( const auto& entry: registry.entries() )
+    compute[ entry.name() ] = entry.compute();
+
+  auto thunk = [ & ]( const std::string& name ) -> uint64_t
+  {
+    auto it = compute.find( name );
+    return it == compute.end() ? 0 : it->second;
+  };
+
+  _costs.transaction_base = thunk( "apply_transaction" ) + thunk( "pre_transaction_callback" )
+                            + thunk( "post_transaction_callback" ) + thunk( "get_account_nonce" )
+                            + thunk( "verify_account_nonce" ) + thunk( "set_account_nonce" )
+                            + thunk( "get_account_rc" ) + thunk( "consume_account_rc" )
+                            + thunk( "require_authority" );
+
+  _costs.recover_public_key   = thunk( "recover_public_key" );
+  _costs.sha2_256_base        = thunk( "sha2_256_base" );
+  _costs.sha2_256_per_byte    = thunk( "sha2_256_per_byte" );
+  _costs.deserialize_per_byte = thunk( "deserialize_message_per_byte" );
+  _costs.verify_merkle_root   = thunk( "verify_merkle_root" );
+
+  _costs.upload_contract = thunk( "apply_upload_contract_operation" ) + thunk( "put_object" );
+  _costs.call_contract   = thunk( "apply_call_contract_operation" ) + thunk( "call_contract" )
+                         + thunk( "get_contract_arguments" ) + thunk( "get_entry_point" ) + thunk( "exit_contract" );
+  _costs.set_system_call     = thunk( "apply_set_system_call_operation" ) + thunk( "put_object" );
+  _costs.set_system_contract = thunk( "apply_set_system_contract_operation" ) + thunk( "put_object" );
+}
+
+rc_estimator::rc_estimator():
+    rc_estimator( default_resource_limit_data(), default_compute_bandwidth_registry() )
+{}
+
+rc_estimator rc_estimator::from_genesis( std::istream& stream, genesis_format format )
+{
+  genesis_resources resources;
+  read_genesis_entries( stream,
+                        format,
+                        [ & ]( chain::genesis_entry& entry )
+                        {
+                          resources.add( entry );
+                        } );
+
+  return resources.estimator();
+}
+
+rc_estimator rc_estimator::from_genesis( const chain::genesis_data& data )
+{
+  genesis_resources resources;
+  for( const auto& entry: data.entries() )
+    resources.add( entry );
+
+  return resources.estimator();
+}
+
+void rc_estimator::set_call_compute( uint64_t compute )
+{
+  _call_compute = compute;
+}
+
+void rc_estimator::set_margin( double percent )
+{
+  _margin = percent;
+}
+
+const chain::resource_limit_data& rc_estimator::limits() const
+{
+  return _limits;
+}
+
+resource_estimate rc_estimator::estimate( const protocol::transaction& transaction,
+                                          std::size_t additional_signatures ) const
+{
+  const auto& header = transaction.header();
+
+  // The header as it will be signed: with a merkle root and room for an rc_limit of any size
+  auto header_size = header.ByteSizeLong() + MAX_VARINT_SIZE;
+  if( header.operation_merkle_root().empty() )
+    header_size += field_size( MULTIHASH_SIZE );
+
+  std::size_t transaction_size = field_size( header_size ) + field_size( MULTIHASH_SIZE );
+  for( const auto& op: transaction.operations() )
+    transaction_size += field_size( op.ByteSizeLong() );
+  for( const auto& signature: transaction.signatures() )
+    transaction_size += field_size( signature.size() );
+  transaction_size += additional_signatures * field_size( SIGNATURE_SIZE );
+
+  resource_estimate result;
+  auto& usage = result.usage;
+
+  usage.network_bandwidth = transaction_size;
+
+  usage.compute_bandwidth = _costs.transaction_base + _costs.deserialize_per_byte * transaction_size
+                            + _costs.sha2_256_base + _costs.sha2_256_per_byte * header_size
+                            + _costs.verify_merkle_root
+                            + _costs.recover_public_key
+                                * ( transaction.signatures_size() + additional_signatures );
+
+  // The nonce object is rewritten by every transaction
+  usage.disk_storage = header.nonce().size();
+
+  for( const auto& op: transaction.operations() )
+  {
+    auto op_size = op.ByteSizeLong();
+    usage.compute_bandwidth += _costs.sha2_256_base + _costs.sha2_256_per_byte * op_size;
+
+    if( op.has_upload_contract() )
+    {
+      usage.compute_bandwidth += _costs.upload_contract;
+      usage.disk_storage += op_size;
+    }
+    else if( op.has_call_contract() )
+    {
+      usage.compute_bandwidth += _costs.call_contract + _call_compute;
+    }
+    else if( op.has_set_system_call() )
+    {
+      usage.compute_bandwidth += _costs.set_system_call;
+      usage.disk_storage += op.set_system_call().target().ByteSizeLong();
+    }
+    else if( op.has_set_system_contract() )
+    {
+      usage.compute_bandwidth += _costs.set_system_contract;
+      usage.disk_storage += op_size;
+    }
+  }
+
+  result.rc = usage.disk_storage * _limits.disk_storage_cost()
+              + usage.network_bandwidth * _limits.network_bandwidth_cost()
+              + usage.compute_bandwidth * _limits.compute_bandwidth_cost();
+
+  result.rc_limit = uint64_t( std::ceil( result.rc * ( 1.0 + _margin / 100.0 ) ) );
+
+  result.exceeds_limits = usage.disk_storage > _limits.disk_storage_limit()
+                          || usage.network_bandwidth > _limits.network_bandwidth_limit()
+                          || usage.compute_bandwidth > _limits.compute_bandwidth_limit();
+
+  return result;
+}
+
+} // namespace koinos::tools
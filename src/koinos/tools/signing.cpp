@@ -0,0 +1,200 @@
+#include <koinos/tools/signing.hpp>
+
+#include <fstream>
+#include <stdexcept>
+
+#include <koinos/log.hpp>
+#include <koinos/util/conversion.hpp>
+
+#include <koinos/tools/resources.hpp>
+#include <koinos/tools/stats.hpp>
+#include <koinos/tools/transaction.hpp>
+
+namespace koinos::tools {
+
+bool add_signature( protocol::transaction& transaction, const std::string& signature )
+{
+  for( const auto& existing: transaction.signatures() )
+  {
+    if( existing == signature )
+      return false;
+  }
+
+  *transaction.add_signatures() = signature;
+  return true;
+}
+
+void sign_transaction( protocol::transaction& transaction, const std::vector< crypto::private_key >& signing_keys )
+{
+  // Signature is on the hash of the active data
+  crypto::multihash trx_id;
+
+  {
+    stage_timer timer( stage::hash );
+    trx_id = crypto::hash( crypto::multicodec::sha2_256, transaction.header() );
+  }
+
+  auto id = util::converter::as< std::string >( trx_id );
+
+  if( transaction.id() != id )
+  {
+    // Existing signatures were made over a different header, such as before finalizing or setting the rc_limit, and
+    // no longer verify
+    if( transaction.signatures_size() )
+    {
+      LOG( warning ) << "Dropping " << transaction.signatures_size()
+                     << " signatures made before the transaction header changed";
+      transaction.clear_signatures();
+    }
+
+    transaction.set_id( id );
+  }
+
+  for( const auto& key: signing_keys )
+  {
+    stage_timer timer( stage::sign );
+    add_signature( transaction, util::converter::as< std::string >( key.sign_compact( trx_id ) ) );
+  }
+}
+
+void wrap_transaction( protocol::transaction& transaction, rpc::chain::chain_request& request )
+{
+  request.Clear();
+  request.mutable_submit_transaction()->mutable_transaction()->Swap( &transaction );
+}
+
+void unwrap_transaction( rpc::chain::chain_request& request, protocol::transaction& transaction )
+{
+  if( !request.has_submit_transaction() )
+    throw std::runtime_error( "request does not contain a transaction" );
+
+  transaction.Swap( request.mutable_submit_transaction()->mutable_transaction() );
+}
+
+crypto::private_key read_keyfile( std::string key_filename )
+{
+  stage_timer timer( stage::key_load );
+
+  // Read base58 wif string from given file
+  std::string key_string;
+  std::ifstream instream;
+  instream.open( key_filename );
+  std::getline( instream, key_string );
+  instream.close();
+
+  // Create and return the key from the wif
+  auto key = crypto::private_key::from_wif( key_string );
+  return key;
+}
+
+std::vector< crypto::private_key > read_keyring( const std::string& keyring_filename )
+{
+  stage_timer timer( stage::key_load );
+  std::ifstream instream( keyring_filename );
+
+  if( !instream )
+    throw std::runtime_error( "unable to open keyring " + keyring_filename );
+
+  std::vector< crypto::private_key > keys;
+  std::string key_string;
+
+  while( std::getline( instream, key_string ) )
+  {
+    if( !key_string.empty() )
+      keys.emplace_back( crypto::private_key::from_wif( key_string ) );
+  }
+
+  return keys;
+}
+
+void read_transaction( const std::string& record, const record_options& opts, sign_context& ctx )
+{
+  ctx.transaction.Clear();
+
+  if( opts.unwrap )
+  {
+    ctx.request.Clear();
+    parse_record( record, opts, ctx.request );
+    unwrap_transaction( ctx.request, ctx.transaction );
+  }
+  else
+  {
+    parse_record( record, opts, ctx.transaction );
+  }
+}
+
+void prepare_transaction( protocol::transaction& transaction, const record_options& opts, std::size_t signing_keys )
+{
+  if( opts.estimator && !transaction.header().rc_limit() )
+    transaction.mutable_header()->set_rc_limit( opts.estimator->estimate( transaction, signing_keys ).rc_limit );
+
+  if( opts.finalize )
+    finalize_transaction( transaction );
+}
+
+void write_transaction( const record_options& opts, sign_context& ctx, std::string& output )
+{
+  if( opts.wrap )
+  {
+    wrap_transaction( ctx.transaction, ctx.request );
+    serialize_record( ctx.request, opts, output );
+  }
+  else
+  {
+    serialize_record( ctx.transaction, opts, output );
+  }
+}
+
+void write_error( uint64_t position,
+                  const std::string& what,
+                  const record_options& opts,
+                  sign_context& ctx,
+                  std::string& output )
+{
+  if( opts.output == record_format::json || opts.output == record_format::compact )
+  {
+    std::string error_str;
+    ctx.error.set_string_value( what );
+    google::protobuf::util::MessageToJsonString( ctx.error, &error_str );
+    output = "{\"record\":" + std::to_string( position ) + ",\"error\":" + error_str + "}\n";
+  }
+  else
+  {
+    // Binary consumers receive an empty transaction, the reason goes to the log
+    LOG( error ) << "Record " << position << ": " << what;
+    ctx.transaction.Clear();
+    write_transaction( opts, ctx, output );
+  }
+}
+
+bool sign_record( sign_job& job,
+                  const std::vector< crypto::private_key >& signing_keys,
+                  const record_options& opts,
+                  sign_context& ctx,
+                  std::string& output )
+{
+  try
+  {
+    if( !job.error.empty() )
+      throw std::runtime_error( job.error );
+
+    if( job.transaction )
+      ctx.transaction.Swap( &*job.transaction );
+    else
+      read_transaction( job.record, opts, ctx );
+
+    prepare_transaction( ctx.transaction, opts, signing_keys.size() );
+    sign_transaction( ctx.transaction, signing_keys );
+    write_transaction( opts, ctx, output );
+
+    return true;
+  }
+  catch( const std::exception& e )
+  {
+    write_error( job.position, e.what(), opts, ctx, output );
+  }
+
+  return false;
+}
+
+} // namespace koinos::tools
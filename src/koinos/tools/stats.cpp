@@ -0,0 +1,363 @@
+#include <koinos/tools/stats.hpp>
+
+#include <algorithm>
+#include <array>
+#include <cstdio>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <stdexcept>
+#include <vector>
+
+#include <koinos/log.hpp>
+
+#include <koinos/tools/latency_histogram.hpp>
+
+// Command line option definitions
+#define STATS_OPTION "stats"
+
+#define STATS_FORMAT_OPTION "stats-format"
+
+#define STATS_FILE_OPTION "stats-file"
+
+#define STATS_DUMP_INTERVAL_OPTION "stats-dump-interval"
+
+namespace koinos::tools {
+
+namespace {
+
+// The counters of a single thread. Only the owning thread records into them, reports read them from any thread.
+struct thread_stats
+{
+  std::array< latency_histogram, stage_count > latency;
+  std::array< std::atomic< uint64_t >, stage_count > bytes{};
+};
+
+struct stats_registry
+{
+  std::mutex mutex;
+
+  // Stats of the running threads that have recorded any
+  std::vector< const thread_stats* > threads;
+
+  // Stats of threads that have exited, merged so a final report covers finished workers without keeping each one.
+  // Tools that start threads per connection would otherwise grow the registry for as long as they run.
+  thread_stats retired;
+};
+
+stats_registry& registry()
+{
+  static stats_registry instance;
+  return instance;
+}
+
+// Registers the owning thread's stats on first use and retires them into the registry when the thread exits
+class local_stats_holder
+{
+public:
+  local_stats_holder():
+      _stats( std::make_unique< thread_stats >() )
+  {
+    std::lock_guard lock( registry().mutex );
+    registry().threads.push_back( _stats.get() );
+  }
+
+  ~local_stats_holder()
+  {
+    auto& reg = registry();
+    std::lock_guard lock( reg.mutex );
+
+    for( std::size_t i = 0; i < stage_count; i++ )
+    {
+      reg.retired.latency[ i ].merge( _stats->latency[ i ] );
+      reg.retired.bytes[ i ].fetch_add( _stats->bytes[ i ].load( std::memory_order_relaxed ),
+                                        std::memory_order_relaxed );
+    }
+
+    reg.threads.erase( std::find( reg.threads.begin(), reg.threads.end(), _stats.get() ) );
+  }
+
+  local_stats_holder( const local_stats_holder& )            = delete;
+  local_stats_holder& operator=( const local_stats_holder& ) = delete;
+
+  thread_stats& stats()
+  {
+    return *_stats;
+  }
+
+private:
+  std::unique_ptr< thread_stats > _stats;
+};
+
+std::atomic< bool > enabled = false;
+std::atomic< int64_t > enabled_since;
+
+thread_stats& local_stats()
+{
+  thread_local local_stats_holder local;
+  return local.stats();
+}
+
+const std::array< double, 3 > quantiles = { 0.5, 0.9, 0.99 };
+
+double seconds( std::chrono::nanoseconds duration )
+{
+  return std::chrono::duration< double >( duration ).count();
+}
+
+} // namespace
+
+const char* stage_name( stage s )
+{
+  switch( s )
+  {
+    case stage::key_load:
+      return "key_load";
+    case stage::parse:
+      return "parse";
+    case stage::hash:
+      return "hash";
+    case stage::sign:
+      return "sign";
+    case stage::verify:
+      return "verify";
+    case stage::serialize:
+      return "serialize";
+    case stage::write:
+      return "write";
+  }
+
+  return "unknown";
+}
+
+stats_format parse_stats_format( const std::string& name )
+{
+  if( name == "json" )
+    return stats_format::json;
+  if( name == "prometheus" )
+    return stats_format::prometheus;
+
+  throw std::invalid_argument( "unknown stats format '" + name + "', expected json or prometheus" );
+}
+
+void enable_stats( bool enable )
+{
+  if( enable && !enabled.load( std::memory_order_relaxed ) )
+    enabled_since.store( std::chrono::steady_clock::now().time_since_epoch().count(), std::memory_order_relaxed );
+
+  enabled.store( enable, std::memory_order_relaxed );
+}
+
+bool stats_enabled()
+{
+  return enabled.load( std::memory_order_relaxed );
+}
+
+void add_stage_bytes( stage s, uint64_t bytes )
+{
+  if( stats_enabled() )
+    local_stats().bytes[ std::size_t( s ) ].fetch_add( bytes, std::memory_order_relaxed );
+}
+
+void stage_timer::record( stage s, std::chrono::nanoseconds duration )
+{
+  local_stats().latency[ std::size_t( s ) ].record( duration );
+}
+
+void write_stats( std::ostream& stream, stats_format format, const std::string& tool )
+{
+  auto latency = std::make_unique< std::array< latency_histogram, stage_count > >();
+  std::array< uint64_t, stage_count > bytes{};
+
+  auto add = [ & ]( const thread_stats& thread )
+  {
+    for( std::size_t i = 0; i < stage_count; i++ )
+    {
+      ( *latency )[ i ].merge( thread.latency[ i ] );
+      bytes[ i ] += thread.bytes[ i ].load( std::memory_order_relaxed );
+    }
+  };
+
+  {
+    std::lock_guard lock( registry().mutex );
+
+    add( registry().retired );
+    for( const auto* thread: registry().threads )
+      add( *thread );
+  }
+
+  auto since   = std::chrono::steady_clock::time_point(
+    std::chrono::steady_clock::duration( enabled_since.load( std::memory_order_relaxed ) ) );
+  auto elapsed = seconds( std::chrono::steady_clock::now() - since );
+
+  if( format == stats_format::json )
+  {
+    stream << "{\"tool\":\"" << tool << "\",\"elapsed_seconds\":" << elapsed << ",\"stages\":{";
+
+    bool first = true;
+    for( std::size_t i = 0; i < stage_count; i++ )
+    {
+      const auto& histogram = ( *latency )[ i ];
+      if( !histogram.count() && !bytes[ i ] )
+        continue;
+
+      stream << ( first ? "" : "," ) << "\"" << stage_name( stage( i ) ) << "\":{\"count\":" << histogram.count()
+             << ",\"per_second\":" << ( elapsed > 0 ? histogram.count() / elapsed : 0 )
+             << ",\"total_seconds\":" << seconds( histogram.total() ) << ",\"mean_ns\":" << histogram.mean().count();
+
+      for( auto quantile: quantiles )
+        stream << ",\"p" << int( quantile * 100 ) << "_ns\":" << histogram.percentile( quantile ).count();
+
+      stream << ",\"max_ns\":" << histogram.max().count() << ",\"bytes\":" << bytes[ i ] << "}";
+      first = false;
+    }
+
+    stream << "}}\n";
+    return;
+  }
+
+  auto labels = [ & ]( std::size_t i )
+  {
+    return "tool=\"" + tool + "\",stage=\"" + stage_name( stage( i ) ) + "\"";
+  };
+
+  stream << "# HELP koinos_tools_stage_duration_seconds Time spent in each pipeline stage\n"
+         << "# TYPE koinos_tools_stage_duration_seconds summary\n";
+
+  for( std::size_t i = 0; i < stage_count; i++ )
+  {
+    const auto& histogram = ( *latency )[ i ];
+    if( !histogram.count() )
+      continue;
+
+    for( auto quantile: quantiles )
+      stream << "koinos_tools_stage_duration_seconds{" << labels( i ) << ",quantile=\"" << quantile << "\"} "
+             << seconds( histogram.percentile( quantile ) ) << "\n";
+
+    stream << "koinos_tools_stage_duration_seconds_sum{" << labels( i ) << "} " << seconds( histogram.total() )
+           << "\n"
+           << "koinos_tools_stage_duration_seconds_count{" << labels( i ) << "} " << histogram.count() << "\n";
+  }
+
+  stream << "# HELP koinos_tools_stage_bytes_total Bytes processed by each pipeline stage\n"
+         << "# TYPE koinos_tools_stage_bytes_total counter\n";
+
+  for( std::size_t i = 0; i < stage_count; i++ )
+  {
+    if( bytes[ i ] )
+      stream << "koinos_tools_stage_bytes_total{" << labels( i ) << "} " << bytes[ i ] << "\n";
+  }
+
+  stream << "# HELP koinos_tools_elapsed_seconds Time since stats collection started\n"
+         << "# TYPE koinos_tools_elapsed_seconds gauge\n"
+         << "koinos_tools_elapsed_seconds{tool=\"" << tool << "\"} " << elapsed << "\n";
+}
+
+stats_reporter::stats_reporter( std::string tool,
+                                stats_format format,
+                                std::string filename,
+                                std::chrono::seconds interval ):
+    _tool( std::move( tool ) ),
+    _format( format ),
+    _filename( std::move( filename ) ),
+    _interval( interval )
+{
+  if( _interval.count() <= 0 )
+    return;
+
+  _thread = std::thread(
+    [ this ]()
+    {
+      std::unique_lock lock( _mutex );
+
+      while( !_cv.wait_for( lock,
+                            _interval,
+                            [ this ]()
+                            {
+                              return _stopping;
+                            } ) )
+      {
+        lock.unlock();
+        report();
+        lock.lock();
+      }
+    } );
+}
+
+stats_reporter::~stats_reporter()
+{
+  {
+    std::lock_guard lock( _mutex );
+    _stopping = true;
+  }
+
+  _cv.notify_all();
+
+  if( _thread.joinable() )
+    _thread.join();
+
+  report();
+}
+
+void stats_reporter::report()
+{
+  try
+  {
+    std::ostringstream stream;
+    write_stats( stream, _format, _tool );
+
+    if( _filename.empty() )
+    {
+      std::cerr << stream.str() << std::flush;
+      return;
+    }
+
+    auto temporary = _filename + ".tmp";
+
+    {
+      std::ofstream output( temporary, std::ios::trunc );
+      output << stream.str();
+      output.close();
+
+      if( !output )
+        throw std::runtime_error( "unable to write " + temporary );
+    }
+
+    if( std::rename( temporary.c_str(), _filename.c_str() ) )
+      throw std::runtime_error( "unable to replace " + _filename );
+  }
+  catch( const std::exception& e )
+  {
+    LOG( warning ) << "Unable to report stats: " << e.what();
+  }
+}
+
+void add_stats_options( boost::program_options::options_description& options )
+{
+  options.add_options()( STATS_OPTION, "collect per stage timing and throughput, reported on exit" )(
+    STATS_FORMAT_OPTION,
+    boost::program_options::value< std::string >()->default_value( "json" ),
+    "stats report format, json or prometheus" )(
+    STATS_FILE_OPTION,
+    boost::program_options::value< std::string >(),
+    "file the stats report replaces, defaults to STDERR" )(
+    STATS_DUMP_INTERVAL_OPTION,
+    boost::program_options::value< uint32_t >()->default_value( 0 ),
+    "seconds between stats reports while running, 0 reports on exit only" );
+}
+
+std::unique_ptr< stats_reporter > make_stats_reporter( const boost::program_options::variables_map& vm,
+                                                       const std::string& tool )
+{
+  if( !vm.count( STATS_OPTION ) )
+    return {};
+
+  auto format   = parse_stats_format( vm[ STATS_FORMAT_OPTION ].as< std::string >() );
+  auto filename = vm.count( STATS_FILE_OPTION ) ? vm[ STATS_FILE_OPTION ].as< std::string >() : std::string();
+  auto interval = std::chrono::seconds( vm[ STATS_DUMP_INTERVAL_OPTION ].as< uint32_t >() );
+
+  enable_stats();
+  return std::make_unique< stats_reporter >( tool, format, filename, interval );
+}
+
+} // namespace koinos::tools
@@ -0,0 +1,127 @@
+#include <koinos/tools/transaction.hpp>
+
+#include <fstream>
+#include <sstream>
+#include <stdexcept>
+
+#include <koinos/util/base58.hpp>
+#include <koinos/util/conversion.hpp>
+
+#include <koinos/chain/value.pb.h>
+
+#include <koinos/tools/merkle_tree.hpp>
+#include <koinos/tools/stats.hpp>
+
+namespace koinos::tools {
+
+std::vector< crypto::multihash > hash_operations( const protocol::transaction& transaction )
+{
+  stage_timer timer( stage::hash );
+  std::vector< crypto::multihash > hashes;
+  hashes.reserve( transaction.operations_size() );
+
+  for( const auto& op: transaction.operations() )
+    hashes.emplace_back( crypto::hash( crypto::multicodec::sha2_256, op ) );
+
+  return hashes;
+}
+
+crypto::multihash operation_merkle_root( const std::vector< crypto::multihash >& operation_hashes )
+{
+  return merkle_tree( crypto::multicodec::sha2_256, operation_hashes ).root();
+}
+
+bool is_finalized( const protocol::transaction& transaction )
+{
+  if( transaction.header().operation_merkle_root().empty() || transaction.id().empty() )
+    return false;
+
+  return transaction.id()
+         == util::converter::as< std::string >( crypto::hash( crypto::multicodec::sha2_256, transaction.header() ) );
+}
+
+bool finalize_transaction( protocol::transaction& transaction )
+{
+  if( is_finalized( transaction ) )
+    return false;
+
+  auto root = operation_merkle_root( hash_operations( transaction ) );
+  transaction.mutable_header()->set_operation_merkle_root( util::converter::as< std::string >( root ) );
+  return true;
+}
+
+std::string encode_nonce( uint64_t nonce )
+{
+  chain::value_type nonce_value;
+  nonce_value.set_uint64_value( nonce );
+  return util::converter::as< std::string >( nonce_value );
+}
+
+uint64_t decode_nonce( const std::string& nonce )
+{
+  return util::converter::to< chain::value_type >( nonce ).uint64_value();
+}
+
+const std::string& nonce_account( const protocol::transaction& transaction )
+{
+  const auto& header = transaction.header();
+  return header.payee().empty() ? header.payer() : header.payee();
+}
+
+void nonce_tracker::set_account_nonce( const std::string& account, uint64_t nonce )
+{
+  _next_nonce[ account ] = nonce + 1;
+}
+
+void nonce_tracker::load( const std::string& filename )
+{
+  std::ifstream instream( filename );
+
+  if( !instream )
+    throw std::runtime_error( "unable to open nonce file " + filename );
+
+  std::string line;
+  uint64_t line_number = 0;
+
+  while( std::getline( instream, line ) )
+  {
+    line_number++;
+
+    if( line.empty() || line.front() == '#' )
+      continue;
+
+    std::istringstream fields( line );
+    std::string address;
+    uint64_t nonce;
+
+    if( !( fields >> address >> nonce ) )
+      throw std::runtime_error( filename + ":" + std::to_string( line_number ) + ": expected '<address> <nonce>'" );
+
+    set_account_nonce( util::from_base58< std::string >( address ), nonce );
+  }
+}
+
+void nonce_tracker::assign( protocol::transaction& transaction )
+{
+  const auto& account = nonce_account( transaction );
+
+  if( account.empty() )
+    throw std::runtime_error( "transaction has no payer to assign a nonce for" );
+
+  if( !transaction.header().nonce().empty() )
+  {
+    set_account_nonce( account, decode_nonce( transaction.header().nonce() ) );
+    return;
+  }
+
+  auto itr = _next_nonce.find( account );
+
+  if( itr == _next_nonce.end() )
+    throw std::runtime_error( "unknown nonce for "
+                              + std::string( transaction.header().payee().empty() ? "payer " : "payee " )
+                              + util::to_base58( account ) );
+
+  transaction.mutable_header()->set_nonce( encode_nonce( itr->second++ ) );
+}
+
+} // namespace koinos::tools
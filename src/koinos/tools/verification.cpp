@@ -0,0 +1,96 @@
+#include <koinos/tools/verification.hpp>
+
+#include <algorithm>
+#include <stdexcept>
+
+#include <koinos/crypto/elliptic.hpp>
+#include <koinos/util/base58.hpp>
+#include <koinos/util/conversion.hpp>
+
+#include <koinos/tools/stats.hpp>
+#include <koinos/tools/transaction.hpp>
+
+namespace koinos::tools {
+
+std::string recover_signer( const std::string& signature, const crypto::multihash& digest )
+{
+  if( signature.size() != std::tuple_size_v< crypto::recoverable_signature > )
+    throw std::runtime_error( "signature is " + std::to_string( signature.size() ) + " bytes, expected "
+                              + std::to_string( std::tuple_size_v< crypto::recoverable_signature > ) );
+
+  stage_timer timer( stage::verify );
+  auto compact = util::converter::to< crypto::recoverable_signature >( signature );
+
+  if( !crypto::public_key::is_canonical( compact ) )
+    throw std::runtime_error( "signature is not canonical" );
+
+  return crypto::public_key::recover( compact, digest ).to_address_bytes();
+}
+
+void verify_transaction( const protocol::transaction& transaction,
+                         const verify_options& opts,
+                         verify_result& result )
+{
+  result.signers.clear();
+  result.errors.clear();
+
+  const auto& header = transaction.header();
+
+  if( !opts.chain_id.empty() && header.chain_id() != opts.chain_id )
+    result.errors.emplace_back( "chain id does not match" );
+
+  crypto::multihash id;
+
+  {
+    stage_timer timer( stage::hash );
+    id = crypto::hash( crypto::multicodec::sha2_256, header );
+  }
+
+  if( transaction.id() != util::converter::as< std::string >( id ) )
+    result.errors.emplace_back( "id is not the hash of the header" );
+
+  if( header.operation_merkle_root()
+      != util::converter::as< std::string >( operation_merkle_root( hash_operations( transaction ) ) ) )
+    result.errors.emplace_back( "operation merkle root does not match the operations" );
+
+  if( transaction.signatures().empty() )
+    result.errors.emplace_back( "transaction is not signed" );
+
+  // Keys are recovered against the hash of the header, so signatures are checked even when the id is wrong
+  for( int i = 0; i < transaction.signatures_size(); i++ )
+  {
+    try
+    {
+      auto signer = recover_signer( transaction.signatures( i ), id );
+
+      if( std::find( result.signers.begin(), result.signers.end(), signer ) != result.signers.end() )
+        result.errors.emplace_back( "signature " + std::to_string( i ) + " duplicates a signer" );
+      else if( !opts.signers.empty() && !opts.signers.count( signer ) )
+        result.errors.emplace_back( "signature " + std::to_string( i ) + " is from unexpected signer "
+                                    + util::to_base58( signer ) );
+
+      result.signers.emplace_back( std::move( signer ) );
+    }
+    catch( const std::exception& e )
+    {
+      result.errors.emplace_back( "signature " + std::to_string( i ) + ": " + e.what() );
+    }
+  }
+
+  // The payer authorizes the rc charge in every case, a payee authorizes the use of its nonce in addition
+  if( opts.require_payer )
+  {
+    auto require_signer = [ & ]( const std::string& account, const char* role )
+    {
+      if( std::find( result.signers.begin(), result.signers.end(), account ) == result.signers.end() )
+        result.errors.emplace_back( std::string( "not signed by " ) + role + " " + util::to_base58( account ) );
+    };
+
+    require_signer( header.payer(), "payer" );
+
+    if( !header.payee().empty() )
+      require_signer( header.payee(), "payee" );
+  }
+}
+
+} // namespace koinos::tools
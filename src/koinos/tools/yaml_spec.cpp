@@ -0,0 +1,145 @@
+#include "yaml_spec.hpp"
+
+#include <fstream>
+#include <memory>
+#include <stdexcept>
+
+#include <google/protobuf/descriptor.h>
+#include <google/protobuf/dynamic_message.h>
+#include <google/protobuf/util/json_util.h>
+
+#include <nlohmann/json.hpp>
+
+#include <koinos/crypto/elliptic.hpp>
+#include <koinos/crypto/multihash.hpp>
+#include <koinos/util/base58.hpp>
+#include <koinos/util/base64.hpp>
+#include <koinos/util/conversion.hpp>
+#include <koinos/util/hex.hpp>
+
+namespace koinos::tools::spec {
+
+std::string describe( const YAML::Node& node )
+{
+  auto mark = node.Mark();
+  return "line " + std::to_string( mark.line + 1 ) + ", column " + std::to_string( mark.column + 1 );
+}
+
+nlohmann::json yaml_to_json( const YAML::Node& node )
+{
+  switch( node.Type() )
+  {
+    case YAML::NodeType::Map:
+      {
+        auto object = nlohmann::json::object();
+        for( const auto& field: node )
+          object[ field.first.as< std::string >() ] = yaml_to_json( field.second );
+        return object;
+      }
+    case YAML::NodeType::Sequence:
+      {
+        auto array = nlohmann::json::array();
+        for( const auto& element: node )
+          array.push_back( yaml_to_json( element ) );
+        return array;
+      }
+    case YAML::NodeType::Scalar:
+      {
+        const auto& scalar = node.Scalar();
+        if( node.Tag() == "!" )
+          return scalar;
+
+        if( scalar == "true" || scalar == "false" || scalar == "null" )
+          return nlohmann::json::parse( scalar );
+
+        if( auto number = nlohmann::json::parse( scalar, nullptr, false ); number.is_number() )
+          return number;
+
+        return scalar;
+      }
+    default:
+      return nullptr;
+  }
+}
+
+std::string read_file( const std::filesystem::path& path )
+{
+  std::ifstream stream( path, std::ios::binary );
+  if( !stream )
+    throw std::runtime_error( "unable to open " + path.string() );
+
+  std::string contents;
+  contents.resize( std::filesystem::file_size( path ) );
+  stream.read( contents.data(), contents.size() );
+
+  if( !stream )
+    throw std::runtime_error( "error reading " + path.string() );
+
+  return contents;
+}
+
+std::string serialize_message( const std::string& type, const YAML::Node& fields )
+{
+  auto descriptor = google::protobuf::DescriptorPool::generated_pool()->FindMessageTypeByName( type );
+  if( !descriptor )
+    throw std::runtime_error( "unknown message type '" + type + "'" );
+
+  std::unique_ptr< google::protobuf::Message > message(
+    google::protobuf::MessageFactory::generated_factory()->GetPrototype( descriptor )->New() );
+
+  auto status = google::protobuf::util::JsonStringToMessage( yaml_to_json( fields ).dump(), message.get() );
+  if( !status.ok() )
+    throw std::runtime_error( "unable to parse " + type + " at " + describe( fields ) + ": " + status.ToString() );
+
+  return message->SerializeAsString();
+}
+
+std::string parse_bytes( const YAML::Node& node, const std::filesystem::path& base_dir )
+{
+  if( !node.IsMap() )
+    throw std::runtime_error( "expected a byte value at " + describe( node ) );
+
+  if( auto value = node[ "address" ] )
+    return util::from_base58< std::string >( value.as< std::string >() );
+  if( auto value = node[ "base58" ] )
+    return util::from_base58< std::string >( value.as< std::string >() );
+  if( auto value = node[ "base64" ] )
+    return util::from_base64< std::string >( value.as< std::string >() );
+  if( auto value = node[ "hex" ] )
+    return util::from_hex< std::string >( value.as< std::string >() );
+  if( auto value = node[ "string" ] )
+    return value.as< std::string >();
+  if( auto value = node[ "hash" ] )
+    return util::converter::as< std::string >(
+      crypto::hash( crypto::multicodec::sha2_256, value.as< std::string >() ) );
+  if( auto value = node[ "varint" ] )
+    return util::converter::as< std::string >( unsigned_varint{ value.as< uint64_t >() } );
+  if( auto value = node[ "wif" ] )
+    return crypto::private_key::from_wif( value.as< std::string >() ).get_public_key().to_address_bytes();
+  if( auto value = node[ "message" ] )
+    return serialize_message( value.as< std::string >(),
+                              node[ "fields" ] ? node[ "fields" ] : YAML::Node( YAML::NodeType::Map ) );
+
+  if( auto value = node[ "file" ] )
+  {
+    auto path = std::filesystem::path( value.as< std::string >() );
+    if( path.is_relative() )
+      path = base_dir / path;
+
+    auto contents = read_file( path );
+    auto encoding = node[ "encoding" ] ? node[ "encoding" ].as< std::string >() : std::string( "binary" );
+
+    if( encoding == "binary" )
+      return contents;
+    if( encoding == "hex" )
+      return util::from_hex< std::string >( contents.substr( 0, contents.find_last_not_of( " \n\r\t" ) + 1 ) );
+    if( encoding == "base64" )
+      return util::from_base64< std::string >( contents.substr( 0, contents.find_last_not_of( " \n\r\t" ) + 1 ) );
+
+    throw std::runtime_error( "unknown file encoding '" + encoding + "' at " + describe( node ) );
+  }
+
+  throw std::runtime_error( "unrecognized byte value at " + describe( node ) );
+}
+
+} // namespace koinos::tools::spec
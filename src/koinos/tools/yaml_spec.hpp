@@ -0,0 +1,28 @@
+#pragma once
+
+#include <filesystem>
+#include <string>
+
+#include <nlohmann/json.hpp>
+
+#include <yaml-cpp/yaml.h>
+
+// Helpers shared by the loaders of the YAML (or JSON) spec files, private to the library since yaml-cpp is not part of
+// its interface
+namespace koinos::tools::spec {
+
+// The position of a node in its file, for error messages
+std::string describe( const YAML::Node& node );
+
+// Plain YAML scalars keep their natural JSON types, quoted scalars are always strings
+nlohmann::json yaml_to_json( const YAML::Node& node );
+
+std::string read_file( const std::filesystem::path& path );
+
+// Serialize a protobuf message given by its full name with fields as in its JSON mapping
+std::string serialize_message( const std::string& type, const YAML::Node& fields );
+
+// Decode a byte value (see load_genesis_spec), reading files relative to base_dir
+std::string parse_bytes( const YAML::Node& node, const std::filesystem::path& base_dir );
+
+} // namespace koinos::tools::spec
@@ -0,0 +1,416 @@
+#include <chrono>
+#include <fstream>
+#include <iostream>
+#include <vector>
+
+#include <boost/program_options.hpp>
+
+#include <koinos/crypto/elliptic.hpp>
+#include <koinos/crypto/multihash.hpp>
+#include <koinos/exception.hpp>
+#include <koinos/log.hpp>
+#include <koinos/util/base64.hpp>
+#include <koinos/util/conversion.hpp>
+
+#include <koinos/protocol/protocol.pb.h>
+
+#include <koinos/tools/block.hpp>
+#include <koinos/tools/genesis.hpp>
+#include <koinos/tools/keystore.hpp>
+#include <koinos/tools/ordered_executor.hpp>
+#include <koinos/tools/records.hpp>
+#include <koinos/tools/resources.hpp>
+#include <koinos/tools/stats.hpp>
+
+// Command line option definitions
+#define HELP_OPTION "help"
+#define HELP_FLAG   "h"
+
+#define GENESIS_OPTION "genesis"
+#define GENESIS_FLAG   "g"
+
+#define GENESIS_FORMAT_OPTION "genesis-format"
+
+#define INPUT_FORMAT_OPTION "input-format"
+#define INPUT_FORMAT_FLAG   "i"
+
+#define OUTPUT_OPTION "output"
+#define OUTPUT_FLAG   "o"
+
+#define OUTPUT_FORMAT_OPTION "output-format"
+
+#define SEED_OPTION "seed"
+#define SEED_FLAG   "s"
+
+#define PRODUCERS_OPTION "producers"
+
+#define START_TIME_OPTION "start-time"
+
+#define BLOCK_INTERVAL_OPTION "block-interval"
+
+#define MAX_TRANSACTIONS_OPTION "max-transactions"
+#define MAX_TRANSACTIONS_FLAG   "m"
+
+#define STATE_MERKLE_ROOTS_OPTION "state-merkle-roots"
+
+#define CALL_COMPUTE_OPTION "call-compute"
+
+#define FILL_OPTION "fill"
+
+#define THREADS_OPTION "threads"
+#define THREADS_FLAG   "t"
+
+// Timestamp of the first block when none is given, fixed so that corpora are reproducible (2023-01-01 UTC)
+const uint64_t DEFAULT_START_TIME = 1'672'531'200'000;
+
+// Block time of the chain in milliseconds
+const uint64_t DEFAULT_BLOCK_INTERVAL = 3'000;
+
+// Fraction of each per block limit blocks are packed to when none is given. Contract execution is estimated, so the
+// headroom keeps blocks within the limits a node measures when it applies them.
+const double DEFAULT_FILL = 0.8;
+
+// Blocks in flight per worker thread
+const std::size_t BLOCK_QUEUE_DEPTH_PER_THREAD = 2;
+
+using namespace koinos;
+
+// Read genesis entries into genesis data, whose hash is the chain id
+chain::genesis_data read_genesis_data( const std::string& filename, tools::genesis_format format )
+{
+  std::ifstream stream( filename, std::ios::binary );
+  if( !stream )
+    throw std::runtime_error( "unable to open genesis file " + filename );
+
+  chain::genesis_data data;
+  tools::read_genesis_entries( stream,
+                               format,
+                               [ & ]( chain::genesis_entry& entry )
+                               {
+                                 data.add_entries()->Swap( &entry );
+                               } );
+  return data;
+}
+
+// True if adding usage to a block that has used so much stays within the per block limits
+bool fits( const tools::resource_usage& used,
+           const tools::resource_usage& usage,
+           const chain::resource_limit_data& limits )
+{
+  return used.disk_storage + usage.disk_storage <= limits.disk_storage_limit()
+         && used.network_bandwidth + usage.network_bandwidth <= limits.network_bandwidth_limit()
+         && used.compute_bandwidth + usage.compute_bandwidth <= limits.compute_bandwidth_limit();
+}
+
+// The per block limits scaled down to the fraction of them blocks are packed to
+chain::resource_limit_data fill_limits( const chain::resource_limit_data& limits, double fill )
+{
+  auto filled = limits;
+  filled.set_disk_storage_limit( uint64_t( limits.disk_storage_limit() * fill ) );
+  filled.set_network_bandwidth_limit( uint64_t( limits.network_bandwidth_limit() * fill ) );
+  filled.set_compute_bandwidth_limit( uint64_t( limits.compute_bandwidth_limit() * fill ) );
+  return filled;
+}
+
+void add_usage( tools::resource_usage& used, const tools::resource_usage& usage )
+{
+  used.disk_storage += usage.disk_storage;
+  used.network_bandwidth += usage.network_bandwidth;
+  used.compute_bandwidth += usage.compute_bandwidth;
+}
+
+int main( int argc, char** argv )
+{
+  try
+  {
+    // Setup command line options
+    boost::program_options::options_description options( "Options" );
+    options.add_options()( HELP_OPTION "," HELP_FLAG, "print usage message" )(
+      GENESIS_OPTION "," GENESIS_FLAG,
+      boost::program_options::value< std::string >(),
+      "genesis file of the chain, defaults to the genesis tool's default genesis" )(
+      GENESIS_FORMAT_OPTION,
+      boost::program_options::value< std::string >()->default_value( "auto" ),
+      "format of the genesis file, 'auto', 'json' or 'binary'" )(
+      INPUT_FORMAT_OPTION "," INPUT_FORMAT_FLAG,
+      boost::program_options::value< std::string >()->default_value( "binary" ),
+      "signed transaction input format: json, compact, binary or base64" )(
+      OUTPUT_OPTION "," OUTPUT_FLAG,
+      boost::program_options::value< std::string >(),
+      "file to write blocks to, defaults to STDOUT" )(
+      OUTPUT_FORMAT_OPTION,
+      boost::program_options::value< std::string >()->default_value( "binary" ),
+      "block output format: json, compact, binary or base64" )(
+      SEED_OPTION "," SEED_FLAG,
+      boost::program_options::value< std::string >()->default_value( "producer" ),
+      "seed the block producer keys are derived from, as koinos_get_dev_key derives keys" )(
+      PRODUCERS_OPTION,
+      boost::program_options::value< uint64_t >()->default_value( 1 ),
+      "number of producers signing blocks in turn" )(
+      START_TIME_OPTION,
+      boost::program_options::value< uint64_t >()->default_value( DEFAULT_START_TIME ),
+      "timestamp of the first block in milliseconds since the epoch" )(
+      BLOCK_INTERVAL_OPTION,
+      boost::program_options::value< uint64_t >()->default_value( DEFAULT_BLOCK_INTERVAL ),
+      "milliseconds between block timestamps" )(
+      MAX_TRANSACTIONS_OPTION "," MAX_TRANSACTIONS_FLAG,
+      boost::program_options::value< uint64_t >()->default_value( 0 ),
+      "maximum transactions per block, 0 packs blocks up to the resource limits only" )(
+      STATE_MERKLE_ROOTS_OPTION,
+      boost::program_options::value< std::string >(),
+      "file of base64 previous state merkle roots, one line per block from the genesis state root onwards" )(
+      CALL_COMPUTE_OPTION,
+      boost::program_options::value< uint64_t >()->default_value( 0 ),
+      "compute charged for the contract code run by each call_contract operation, including transfers" )(
+      FILL_OPTION,
+      boost::program_options::value< double >()->default_value( DEFAULT_FILL ),
+      "fraction of the per block resource limits to pack blocks to" )(
+      THREADS_OPTION "," THREADS_FLAG,
+      boost::program_options::value< std::size_t >()->default_value( 0 ),
+      "number of threads computing transaction merkle roots, 0 uses all cores" );
+
+    tools::add_stats_options( options );
+
+    // Parse command-line options
+    boost::program_options::variables_map vm;
+    boost::program_options::store( boost::program_options::parse_command_line( argc, argv, options ), vm );
+
+    // Handle help message
+    if( vm.count( HELP_OPTION ) )
+    {
+      std::cout << "Koinos Block Builder" << std::endl;
+      std::cout << "Accepts signed transactions via STDIN and packs them into signed blocks under the genesis "
+                   "resource limits"
+                << std::endl;
+      std::cout << "Returns a stream of blocks, varint length delimited by default" << std::endl;
+      std::cout << "Packing is only as exact as the compute estimate: contract code is charged --" CALL_COMPUTE_OPTION
+                   " per call and"
+                << std::endl;
+      std::cout << "blocks are filled to --" FILL_OPTION " of the limits, so that nodes applying them stay within the "
+                   "real limits"
+                << std::endl
+                << std::endl;
+      std::cout << options << std::endl;
+      return EXIT_SUCCESS;
+    }
+
+    auto stats = tools::make_stats_reporter( vm, "koinos_block_builder" );
+
+    auto num_threads    = vm[ THREADS_OPTION ].as< std::size_t >();
+    auto num_producers  = vm[ PRODUCERS_OPTION ].as< uint64_t >();
+    auto start_time     = vm[ START_TIME_OPTION ].as< uint64_t >();
+    auto block_interval = vm[ BLOCK_INTERVAL_OPTION ].as< uint64_t >();
+    auto max_trx        = vm[ MAX_TRANSACTIONS_OPTION ].as< uint64_t >();
+    auto fill           = vm[ FILL_OPTION ].as< double >();
+
+    if( !num_producers )
+      throw std::runtime_error( "at least one producer is required" );
+
+    if( !( fill > 0 && fill <= 1 ) )
+      throw std::runtime_error( "--" FILL_OPTION " must be greater than 0 and at most 1" );
+
+    if( !num_threads )
+      num_threads = tools::ordered_executor< protocol::block, protocol::block >::default_concurrency();
+
+    auto genesis_data =
+      vm.count( GENESIS_OPTION )
+        ? read_genesis_data( vm[ GENESIS_OPTION ].as< std::string >(),
+                             tools::parse_genesis_format( vm[ GENESIS_FORMAT_OPTION ].as< std::string >() ) )
+        : tools::default_genesis_data();
+
+    auto chain_id  = util::converter::as< std::string >( crypto::hash( crypto::multicodec::sha2_256, genesis_data ) );
+    auto estimator = tools::rc_estimator::from_genesis( genesis_data );
+    auto limits    = estimator.limits();
+    auto budget    = fill_limits( limits, fill );
+    genesis_data.Clear();
+
+    estimator.set_call_compute( vm[ CALL_COMPUTE_OPTION ].as< uint64_t >() );
+
+    std::vector< crypto::private_key > producers;
+    for( uint64_t i = 0; i < num_producers; i++ )
+      producers.push_back( tools::derive_dev_key( vm[ SEED_OPTION ].as< std::string >(), i ) );
+
+    std::ifstream state_roots;
+    if( vm.count( STATE_MERKLE_ROOTS_OPTION ) )
+    {
+      auto filename = vm[ STATE_MERKLE_ROOTS_OPTION ].as< std::string >();
+      state_roots.open( filename );
+      if( !state_roots )
+        throw std::runtime_error( "unable to open " + filename );
+    }
+
+    auto input_format  = tools::parse_record_format( vm[ INPUT_FORMAT_OPTION ].as< std::string >() );
+    auto output_format = tools::parse_record_format( vm[ OUTPUT_FORMAT_OPTION ].as< std::string >() );
+    auto opts          = tools::make_record_options( input_format, output_format );
+
+    std::ofstream output_file;
+    if( vm.count( OUTPUT_OPTION ) )
+    {
+      auto filename = vm[ OUTPUT_OPTION ].as< std::string >();
+      output_file.open( filename, std::ios::binary );
+      if( !output_file )
+        throw std::runtime_error( "unable to open " + filename );
+    }
+
+    std::ostream& output = output_file.is_open() ? output_file : std::cout;
+
+    std::ios::sync_with_stdio( false );
+    std::cin.tie( nullptr );
+
+    uint64_t height        = 0;
+    uint64_t packed        = 0;
+    uint64_t missing_roots = 0;
+    std::string previous =
+      util::converter::as< std::string >( crypto::multihash::zero( crypto::multicodec::sha2_256 ) );
+    std::string state_root;
+    std::string serialized;
+
+    auto start = std::chrono::steady_clock::now();
+
+    // Transaction merkle roots are computed concurrently, the rest of each header chains on the previous block's id
+    // so blocks are completed and signed in order
+    tools::ordered_executor< protocol::block, protocol::block > executor(
+      num_threads,
+      num_threads * BLOCK_QUEUE_DEPTH_PER_THREAD,
+      [ & ]( protocol::block& block, std::size_t )
+      {
+        block.mutable_header()->set_transaction_merkle_root(
+          util::converter::as< std::string >( tools::transaction_merkle_root( block ) ) );
+        return std::move( block );
+      },
+      [ & ]( protocol::block& block )
+      {
+        height++;
+
+        state_root.clear();
+        if( state_roots.is_open() && std::getline( state_roots, state_root ) )
+          state_root = util::from_base64< std::string >( state_root );
+        else
+          missing_roots++;
+
+        auto header = block.mutable_header();
+        header->set_previous( previous );
+        header->set_height( height );
+        header->set_timestamp( start_time + ( height - 1 ) * block_interval );
+        header->set_previous_state_merkle_root( state_root );
+
+        tools::sign_block( block, producers[ ( height - 1 ) % producers.size() ] );
+        previous = block.id();
+
+        tools::serialize_record( block, opts, serialized );
+
+        tools::stage_timer timer( tools::stage::write );
+        tools::add_stage_bytes( tools::stage::write, serialized.size() );
+        output.write( serialized.data(), serialized.size() );
+      } );
+
+    tools::record_reader reader( opts.input );
+    std::string record;
+    uint64_t records      = 0;
+    uint64_t wrong_chain  = 0;
+    uint64_t too_large    = 0;
+    uint64_t parse_errors = 0;
+    tools::resource_usage used;
+    protocol::block block;
+    protocol::transaction carry;
+
+    while( reader.next( record ) )
+    {
+      records++;
+
+      auto transaction = block.add_transactions();
+
+      try
+      {
+        tools::parse_record( record, opts, *transaction );
+      }
+      catch( const std::exception& e )
+      {
+        if( !parse_errors++ )
+          LOG( warning ) << "Skipping transaction " << records << ": " << e.what();
+        block.mutable_transactions()->RemoveLast();
+        continue;
+      }
+
+      if( transaction->header().chain_id() != chain_id )
+      {
+        wrong_chain++;
+        block.mutable_transactions()->RemoveLast();
+        continue;
+      }
+
+      auto usage = estimator.estimate( *transaction ).usage;
+
+      if( !fits( {}, usage, limits ) )
+      {
+        too_large++;
+        block.mutable_transactions()->RemoveLast();
+        continue;
+      }
+
+      // Close the block before a transaction that would take it past the fraction of its limits it is filled to
+      if( block.transactions_size() > 1
+          && ( !fits( used, usage, budget ) || ( max_trx && uint64_t( block.transactions_size() ) > max_trx ) ) )
+      {
+        carry.Swap( transaction );
+        block.mutable_transactions()->RemoveLast();
+
+        packed += block.transactions_size();
+        executor.push( std::move( block ) );
+
+        block = protocol::block();
+        block.add_transactions()->Swap( &carry );
+        used = tools::resource_usage();
+      }
+
+      add_usage( used, usage );
+    }
+
+    if( block.transactions_size() )
+    {
+      packed += block.transactions_size();
+      executor.push( std::move( block ) );
+    }
+
+    executor.finish();
+    output.flush();
+
+    if( !output )
+      throw std::runtime_error( "error writing blocks" );
+
+    auto elapsed = std::chrono::duration< double >( std::chrono::steady_clock::now() - start ).count();
+    LOG( info ) << "Built " << height << " blocks of " << packed << " transactions in " << elapsed << "s ("
+                << ( elapsed > 0 ? uint64_t( packed / elapsed ) : 0 ) << " transactions/s) on " << num_threads
+                << " threads";
+
+    if( parse_errors )
+      LOG( warning ) << "Skipped " << parse_errors << " transactions that could not be parsed";
+
+    if( wrong_chain )
+      LOG( warning ) << "Skipped " << wrong_chain << " transactions for a different chain id than "
+                     << util::to_base64( chain_id );
+
+    if( too_large )
+      LOG( warning ) << "Skipped " << too_large << " transactions that exceed the block limits on their own";
+
+    if( missing_roots )
+      LOG( warning ) << missing_roots << " blocks have no previous state merkle root, nodes that verify it will "
+                     << "only apply them with roots given by --" STATE_MERKLE_ROOTS_OPTION;
+
+    return EXIT_SUCCESS;
+  }
+  catch( const boost::exception& e )
+  {
+    LOG( fatal ) << boost::diagnostic_information( e ) << std::endl;
+  }
+  catch( const std::exception& e )
+  {
+    LOG( fatal ) << e.what() << std::endl;
+  }
+  catch( ... )
+  {
+    LOG( fatal ) << "unknown exception" << std::endl;
+  }
+
+  return EXIT_FAILURE;
+}
@@ -0,0 +1,499 @@
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <fstream>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <map>
+#include <optional>
+#include <string>
+#include <vector>
+
+#include <boost/program_options.hpp>
+
+#include <nlohmann/json.hpp>
+
+#include <koinos/crypto/elliptic.hpp>
+#include <koinos/crypto/multihash.hpp>
+#include <koinos/exception.hpp>
+#include <koinos/log.hpp>
+#include <koinos/util/conversion.hpp>
+
+#include <koinos/chain/chain.pb.h>
+#include <koinos/protocol/protocol.pb.h>
+
+#include <koinos/tools/genesis.hpp>
+#include <koinos/tools/object_keys.hpp>
+#include <koinos/tools/signing.hpp>
+#include <koinos/tools/stats.hpp>
+#include <koinos/tools/transaction.hpp>
+
+// Command line option definitions
+#define HELP_OPTION "help"
+#define HELP_FLAG   "h"
+
+#define SAMPLES_OPTION "samples"
+#define SAMPLES_FLAG   "n"
+
+#define SAMPLE_TIME_OPTION "sample-time"
+#define SAMPLE_TIME_FLAG   "t"
+
+#define REFERENCE_OPTION "reference"
+#define REFERENCE_FLAG   "r"
+
+#define GENESIS_OPTION "genesis"
+#define GENESIS_FLAG   "g"
+
+#define GENESIS_FORMAT_OPTION "genesis-format"
+
+#define FORMAT_OPTION "format"
+#define FORMAT_FLAG   "f"
+
+#define MAX_CV_OPTION "max-cv"
+
+#define FILTER_OPTION "filter"
+
+// Size of the input used to separate the per byte cost of a hash from its base cost
+const std::size_t PER_BYTE_INPUT_SIZE = 4'096;
+
+// Operations run before sampling each calibration
+const uint64_t WARMUP_ITERATIONS = 16;
+
+using namespace koinos;
+
+// Measures one thunk, returning the nanoseconds per unit (call or byte) of a batch running for about the given time
+struct calibration
+{
+  std::string thunk;
+  std::function< double( std::chrono::nanoseconds ) > sample;
+};
+
+struct calibration_result
+{
+  std::string thunk;
+  std::vector< double > samples;
+  double mean   = 0;
+  double stddev = 0;
+
+  double coefficient_of_variation() const
+  {
+    return mean > 0 ? stddev / mean * 100 : 0;
+  }
+};
+
+// Results are accumulated here so the compiler cannot discard the calibrated operations
+volatile std::size_t calibration_sink = 0;
+
+template< typename T >
+void consume( const T& value )
+{
+  calibration_sink = calibration_sink + value.size();
+}
+
+// Nanoseconds per call of an operation run repeatedly for about the given time
+double time_operation( const std::function< void() >& operation, std::chrono::nanoseconds duration )
+{
+  for( uint64_t i = 0; i < WARMUP_ITERATIONS; i++ )
+    operation();
+
+  uint64_t iterations = 0;
+  auto start          = std::chrono::steady_clock::now();
+  auto end            = start;
+
+  do
+  {
+    operation();
+    iterations++;
+    end = std::chrono::steady_clock::now();
+  }
+  while( end - start < duration );
+
+  return std::chrono::duration< double, std::nano >( end - start ).count() / iterations;
+}
+
+// The base and per byte calibrations of a hash, named the way the registry names them
+std::vector< calibration > hash_calibrations( const std::string& prefix, crypto::multicodec code )
+{
+  const std::string large_input( PER_BYTE_INPUT_SIZE, 'a' );
+
+  auto hash_empty = [ = ]()
+  {
+    consume( crypto::hash( code, std::string() ).digest() );
+  };
+
+  auto hash_large = [ = ]()
+  {
+    consume( crypto::hash( code, large_input ).digest() );
+  };
+
+  return {
+    { prefix + "_base", [ = ]( std::chrono::nanoseconds duration )
+     {
+       return time_operation( hash_empty, duration );
+     } },
+    { prefix + "_per_byte",
+     [ = ]( std::chrono::nanoseconds duration )
+     {
+       // The base cost is charged separately, so only the time beyond hashing an empty input is attributed to bytes
+       auto base  = time_operation( hash_empty, duration / 2 );
+       auto large = time_operation( hash_large, duration / 2 );
+       return std::max( large - base, 0.0 ) / PER_BYTE_INPUT_SIZE;
+     } },
+  };
+}
+
+std::vector< calibration > make_calibrations()
+{
+  auto private_key =
+    crypto::private_key::regenerate( crypto::hash( crypto::multicodec::sha2_256, std::string( "seed" ) ) );
+  auto public_key  = private_key.get_public_key();
+  auto address     = public_key.to_address_bytes();
+
+  // A transaction like the ones the chain applies: one contract call with a token transfer sized payload
+  protocol::transaction transaction;
+  auto header = transaction.mutable_header();
+  header->set_chain_id(
+    util::converter::as< std::string >( crypto::hash( crypto::multicodec::sha2_256, std::string( "chain" ) ) ) );
+  header->set_rc_limit( 100'000'000 );
+  header->set_nonce( tools::encode_nonce( 1 ) );
+  header->set_payer( address );
+
+  auto call = transaction.add_operations()->mutable_call_contract();
+  call->set_contract_id( address );
+  call->set_entry_point( 0x27f576ca );
+  call->set_args( std::string( 72, 'a' ) );
+
+  tools::finalize_transaction( transaction );
+  tools::sign_transaction( transaction, { private_key } );
+
+  auto serialized = util::converter::as< std::string >( transaction );
+
+  auto digest                = crypto::hash( crypto::multicodec::sha2_256, transaction.header() );
+  auto signature             = private_key.sign_compact( digest );
+  std::string proof_input    = util::converter::as< std::string >( digest );
+  auto [ proof, proof_hash ] = private_key.generate_random_proof( proof_input );
+
+  std::vector< calibration > calibrations;
+
+  for( auto [ prefix, code ]: std::vector< std::pair< std::string, crypto::multicodec > >{
+         {      "sha1",       crypto::multicodec::sha1 },
+         {  "sha2_256",   crypto::multicodec::sha2_256 },
+         {  "sha2_512",   crypto::multicodec::sha2_512 },
+         {"keccak_256", crypto::multicodec::keccak_256 },
+         {"ripemd_160", crypto::multicodec::ripemd_160 }
+  } )
+  {
+    auto hashes = hash_calibrations( prefix, code );
+    calibrations.insert( calibrations.end(), hashes.begin(), hashes.end() );
+  }
+
+  calibrations.push_back( { "recover_public_key",
+                            [ = ]( std::chrono::nanoseconds duration )
+                            {
+                              return time_operation(
+                                [ & ]()
+                                {
+                                  consume( crypto::public_key::recover( signature, digest ).serialize() );
+                                },
+                                duration );
+                            } } );
+
+  calibrations.push_back( { "verify_vrf_proof",
+                            [ = ]( std::chrono::nanoseconds duration )
+                            {
+                              return time_operation(
+                                [ & ]()
+                                {
+                                  consume( public_key.verify_random_proof( proof_input, proof ).digest() );
+                                },
+                                duration );
+                            } } );
+
+  calibrations.push_back( { "deserialize_message_per_byte",
+                            [ = ]( std::chrono::nanoseconds duration )
+                            {
+                              return time_operation(
+                                       [ & ]()
+                                       {
+                                         protocol::transaction parsed;
+                                         parsed.ParseFromString( serialized );
+                                         consume( parsed.signatures() );
+                                       },
+                                       duration )
+                                     / serialized.size();
+                            } } );
+
+  calibrations.push_back( { "object_serialization_per_byte",
+                            [ = ]( std::chrono::nanoseconds duration )
+                            {
+                              return time_operation(
+                                       [ & ]()
+                                       {
+                                         consume( transaction.SerializeAsString() );
+                                       },
+                                       duration )
+                                     / serialized.size();
+                            } } );
+
+  return calibrations;
+}
+
+void run_calibration( const calibration& cal,
+                      uint64_t samples,
+                      std::chrono::nanoseconds sample_time,
+                      calibration_result& result )
+{
+  result.thunk = cal.thunk;
+
+  for( uint64_t i = 0; i < samples; i++ )
+    result.samples.push_back( cal.sample( sample_time ) );
+
+  double sum = 0;
+  for( auto s: result.samples )
+    sum += s;
+  result.mean = sum / result.samples.size();
+
+  double squares = 0;
+  for( auto s: result.samples )
+    squares += ( s - result.mean ) * ( s - result.mean );
+  result.stddev = result.samples.size() > 1 ? std::sqrt( squares / ( result.samples.size() - 1 ) ) : 0;
+}
+
+// Read the compute bandwidth registry out of an existing genesis file
+chain::compute_bandwidth_registry read_registry( const std::string& filename, tools::genesis_format format )
+{
+  std::ifstream stream( filename, std::ios::binary );
+  if( !stream )
+    throw std::runtime_error( "unable to open genesis file " + filename );
+
+  auto registry_key = tools::object_key( tools::kernel_object::compute_bandwidth_registry );
+  std::optional< chain::compute_bandwidth_registry > registry;
+
+  tools::read_genesis_entries( stream,
+                               format,
+                               [ & ]( chain::genesis_entry& entry )
+                               {
+                                 if( entry.key() != registry_key )
+                                   return;
+
+                                 registry = util::converter::to< chain::compute_bandwidth_registry >( entry.value() );
+                               } );
+
+  if( !registry )
+    throw std::runtime_error( "genesis file " + filename + " has no compute bandwidth registry" );
+
+  return *registry;
+}
+
+int main( int argc, char** argv )
+{
+  try
+  {
+    // Setup command line options
+    boost::program_options::options_description options( "Options" );
+    options.add_options()( HELP_OPTION "," HELP_FLAG, "print usage message" )(
+      SAMPLES_OPTION "," SAMPLES_FLAG,
+      boost::program_options::value< uint64_t >()->default_value( 10 ),
+      "number of samples taken of each thunk" )( SAMPLE_TIME_OPTION "," SAMPLE_TIME_FLAG,
+                                                 boost::program_options::value< double >()->default_value( 0.1 ),
+                                                 "seconds spent taking each sample" )(
+      REFERENCE_OPTION "," REFERENCE_FLAG,
+      boost::program_options::value< std::string >()->default_value( "sha2_256_base" ),
+      "calibrated thunk whose current cost anchors the new costs" )(
+      GENESIS_OPTION "," GENESIS_FLAG,
+      boost::program_options::value< std::string >(),
+      "genesis file holding the current registry (defaults to the genesis tool's registry)" )(
+      GENESIS_FORMAT_OPTION,
+      boost::program_options::value< std::string >()->default_value( "auto" ),
+      "format of the genesis file, 'auto', 'json' or 'binary'" )(
+      FORMAT_OPTION "," FORMAT_FLAG,
+      boost::program_options::value< std::string >()->default_value( "spec" ),
+      "output format, 'spec' for a genesis spec entry or 'json' for the measurements" )(
+      MAX_CV_OPTION,
+      boost::program_options::value< double >()->default_value( 5.0 ),
+      "coefficient of variation, in percent, above which a measurement is flagged as noisy" )(
+      FILTER_OPTION,
+      boost::program_options::value< std::string >()->default_value( "" ),
+      "only calibrate thunks whose name contains this string (the reference is always calibrated)" );
+
+    tools::add_stats_options( options );
+
+    // Parse command-line options
+    boost::program_options::variables_map vm;
+    boost::program_options::store( boost::program_options::parse_command_line( argc, argv, options ), vm );
+
+    // Handle help message
+    if( vm.count( HELP_OPTION ) )
+    {
+      std::cout << "Koinos Compute Calibration" << std::endl;
+      std::cout << "Measures the thunks backed by local crypto and serialization primitives and regenerates their "
+                   "compute bandwidth costs"
+                << std::endl
+                << std::endl;
+      std::cout << options << std::endl;
+      return EXIT_SUCCESS;
+    }
+
+    auto stats = tools::make_stats_reporter( vm, "koinos_compute_calibration" );
+
+    auto samples     = vm[ SAMPLES_OPTION ].as< uint64_t >();
+    auto reference   = vm[ REFERENCE_OPTION ].as< std::string >();
+    auto format      = vm[ FORMAT_OPTION ].as< std::string >();
+    auto max_cv      = vm[ MAX_CV_OPTION ].as< double >();
+    auto filter      = vm[ FILTER_OPTION ].as< std::string >();
+    auto sample_time = std::chrono::duration_cast< std::chrono::nanoseconds >(
+      std::chrono::duration< double >( vm[ SAMPLE_TIME_OPTION ].as< double >() ) );
+
+    if( samples == 0 )
+      throw std::runtime_error( "at least one sample is required" );
+
+    if( format != "spec" && format != "json" )
+      throw std::runtime_error( "unknown output format " + format );
+
+    auto registry = vm.count( GENESIS_OPTION )
+                      ? read_registry( vm[ GENESIS_OPTION ].as< std::string >(),
+                                       tools::parse_genesis_format( vm[ GENESIS_FORMAT_OPTION ].as< std::string >() ) )
+                      : tools::default_compute_bandwidth_registry();
+
+    std::map< std::string, uint64_t > current;
+    for( const auto& entry: registry.entries() )
+      current[ entry.name() ] = entry.compute();
+
+    auto calibrations = make_calibrations();
+
+    if( std::none_of( calibrations.begin(),
+                      calibrations.end(),
+                      [ & ]( const calibration& cal )
+                      {
+                        return cal.thunk == reference;
+                      } ) )
+      throw std::runtime_error( "reference " + reference + " is not a calibrated thunk" );
+
+    if( !current.count( reference ) || current[ reference ] == 0 )
+      throw std::runtime_error( "reference " + reference + " has no cost in the current registry" );
+
+    std::vector< calibration_result > results;
+
+    for( const auto& cal: calibrations )
+    {
+      if( cal.thunk != reference && cal.thunk.find( filter ) == std::string::npos )
+        continue;
+
+      LOG( info ) << "Calibrating " << cal.thunk;
+      run_calibration( cal, samples, sample_time, results.emplace_back() );
+    }
+
+    auto reference_result = std::find_if( results.begin(),
+                                          results.end(),
+                                          [ & ]( const calibration_result& result )
+                                          {
+                                            return result.thunk == reference;
+                                          } );
+
+    if( reference_result->mean <= 0 )
+      throw std::runtime_error( "reference " + reference + " measured no time" );
+
+    // Compute per nanosecond, anchored so the reference keeps its current cost
+    double scale = current[ reference ] / reference_result->mean;
+
+    std::map< std::string, uint64_t > calibrated = current;
+    uint64_t noisy                               = 0;
+
+    std::cerr << std::left << std::setw( 32 ) << "thunk" << std::right << std::setw( 14 ) << "mean ns"
+              << std::setw( 12 ) << "stddev ns" << std::setw( 8 ) << "cv %" << std::setw( 12 ) << "current"
+              << std::setw( 12 ) << "calibrated" << std::setw( 10 ) << "change" << "\n";
+
+    for( const auto& result: results )
+    {
+      // Every thunk costs at least one unit, which is what the sub-nanosecond per byte costs round up to
+      auto cost                  = std::max< uint64_t >( std::llround( result.mean * scale ), 1 );
+      calibrated[ result.thunk ] = cost;
+
+      auto cv = result.coefficient_of_variation();
+      if( cv > max_cv )
+        noisy++;
+
+      std::cerr << std::left << std::setw( 32 ) << result.thunk << std::right << std::fixed << std::setprecision( 2 )
+                << std::setw( 14 ) << result.mean << std::setw( 12 ) << result.stddev << std::setprecision( 1 )
+                << std::setw( 8 ) << cv << std::setw( 12 );
+
+      if( current.count( result.thunk ) )
+        std::cerr << current[ result.thunk ];
+      else
+        std::cerr << "-";
+
+      std::cerr << std::setw( 12 ) << cost;
+
+      if( current.count( result.thunk ) && current[ result.thunk ] > 0 )
+        std::cerr << std::setw( 9 )
+                  << ( double( cost ) - double( current[ result.thunk ] ) ) / current[ result.thunk ] * 100 << "%";
+
+      std::cerr << ( cv > max_cv ? "  NOISY" : "" ) << "\n";
+    }
+
+    std::cerr << std::flush;
+
+    if( noisy )
+      LOG( warning ) << noisy << " measurements varied by more than " << max_cv
+                     << "%, consider more samples or a quieter machine";
+
+    if( format == "json" )
+    {
+      nlohmann::json output = {
+        {          "reference",                  reference },
+        {"compute_per_nanosecond",                      scale },
+        {       "measurements", nlohmann::json::array() },
+        {           "registry", nlohmann::json::array() }
+      };
+
+      for( const auto& result: results )
+        output[ "measurements" ].push_back( {
+          {   "thunk",                        result.thunk },
+          { "samples",                      result.samples },
+          { "mean_ns",                         result.mean },
+          {"stddev_ns",                       result.stddev },
+          {    "cv_pct", result.coefficient_of_variation() },
+          { "compute",          calibrated[ result.thunk ] }
+        } );
+
+      for( const auto& [ name, compute ]: calibrated )
+        output[ "registry" ].push_back( {
+          {   "name",    name },
+          {"compute", compute }
+        } );
+
+      std::cout << output.dump( 2 ) << std::endl;
+    }
+    else
+    {
+      // An entry for the genesis tool's --spec file, with the thunks that were not measured left unchanged
+      std::cout << "  - key: compute_bandwidth_registry\n"
+                << "    value:\n"
+                << "      message: koinos.chain.compute_bandwidth_registry\n"
+                << "      fields:\n"
+                << "        entries:\n";
+
+      for( const auto& [ name, compute ]: calibrated )
+        std::cout << "          - { name: " << name << ", compute: " << compute << " }\n";
+
+      std::cout << std::flush;
+    }
+
+    return EXIT_SUCCESS;
+  }
+  catch( const boost::exception& e )
+  {
+    LOG( fatal ) << boost::diagnostic_information( e ) << std::endl;
+  }
+  catch( const std::exception& e )
+  {
+    LOG( fatal ) << e.what() << std::endl;
+  }
+  catch( ... )
+  {
+    LOG( fatal ) << "unknown exception" << std::endl;
+  }
+
+  return EXIT_FAILURE;
+}
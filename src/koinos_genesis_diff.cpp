@@ -0,0 +1,473 @@
+#include <algorithm>
+#include <chrono>
+#include <fstream>
+#include <functional>
+#include <iostream>
+#include <optional>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include <boost/program_options.hpp>
+
+#include <google/protobuf/descriptor.pb.h>
+#include <google/protobuf/io/coded_stream.h>
+#include <google/protobuf/util/json_util.h>
+
+#include <nlohmann/json.hpp>
+
+#include <koinos/crypto/multihash.hpp>
+#include <koinos/exception.hpp>
+#include <koinos/log.hpp>
+#include <koinos/util/base58.hpp>
+#include <koinos/util/conversion.hpp>
+#include <koinos/util/hex.hpp>
+
+#include <koinos/chain/chain.pb.h>
+
+#include <koinos/tools/genesis.hpp>
+#include <koinos/tools/object_keys.hpp>
+#include <koinos/tools/stats.hpp>
+
+// Command line option definitions
+#define HELP_OPTION "help"
+#define HELP_FLAG   "h"
+
+#define INPUT_OPTION "input"
+
+#define FORMAT_OPTION "format"
+#define FORMAT_FLAG   "f"
+
+#define JSON_OPTION "json"
+#define JSON_FLAG   "j"
+
+// Raw values longer than this are summarized by their size and hash
+const std::size_t MAX_RAW_VALUE_SIZE = 64;
+
+const std::size_t ADDRESS_SIZE = 25;
+
+// Exit statuses, as diff(1) reports them
+const int EXIT_SAME      = 0;
+const int EXIT_DIFFERENT = 1;
+const int EXIT_TROUBLE   = 2;
+
+using namespace koinos;
+
+// Serialize JSON, replacing invalid UTF-8 from undecoded values rather than failing
+std::string dump( const nlohmann::json& json )
+{
+  return json.dump( -1, ' ', false, nlohmann::json::error_handler_t::replace );
+}
+
+std::string encode_bytes( const std::string& bytes )
+{
+  if( bytes.size() == ADDRESS_SIZE )
+    return util::to_base58( bytes );
+
+  return util::to_hex( bytes );
+}
+
+std::string describe_space( const chain::object_space& space )
+{
+  if( auto name = tools::space_name( space ); !name.empty() )
+    return name;
+
+  return ( space.system() ? "system:" : "" ) + encode_bytes( space.zone() ) + "/" + std::to_string( space.id() );
+}
+
+std::optional< tools::kernel_object > find_kernel_object( const chain::genesis_entry& entry )
+{
+  if( tools::space_name( entry.space() ) != chain::system_space_id_Name( chain::system_space_id::metadata ) )
+    return {};
+
+  return tools::find_kernel_object_by_key( entry.key() );
+}
+
+std::string describe_key( const chain::genesis_entry& entry )
+{
+  if( auto object = find_kernel_object( entry ) )
+    return std::string( tools::object_name( *object ) );
+
+  return encode_bytes( entry.key() );
+}
+
+template< typename Message >
+nlohmann::json message_json( const std::string& value )
+{
+  auto message = util::converter::to< Message >( value );
+
+  google::protobuf::util::JsonPrintOptions options;
+  options.always_print_primitive_fields = true;
+  options.preserve_proto_field_names    = true;
+
+  std::string json;
+  google::protobuf::util::MessageToJsonString( message, &json, options );
+  return nlohmann::json::parse( json );
+}
+
+nlohmann::json raw_json( const std::string& value )
+{
+  if( value.size() <= MAX_RAW_VALUE_SIZE )
+    return encode_bytes( value );
+
+  auto digest = crypto::hash( crypto::multicodec::sha2_256, value );
+
+  return {
+    {     "size",                                               value.size() },
+    { "sha2_256", util::to_hex( util::converter::as< std::string >( digest ) ) }
+  };
+}
+
+// Decode the values of known kernel objects, other values are shown as raw bytes
+nlohmann::json decode_value( const chain::genesis_entry& entry )
+{
+  auto object = find_kernel_object( entry );
+  if( !object )
+    return raw_json( entry.value() );
+
+  switch( *object )
+  {
+    case tools::kernel_object::genesis_key:
+      return encode_bytes( entry.value() );
+    case tools::kernel_object::resource_limit_data:
+      return message_json< chain::resource_limit_data >( entry.value() );
+    case tools::kernel_object::max_account_resources:
+      return message_json< chain::max_account_resources >( entry.value() );
+    case tools::kernel_object::compute_bandwidth_registry:
+      {
+        // Keyed by thunk name so a diff shows each changed cost
+        auto registry = util::converter::to< chain::compute_bandwidth_registry >( entry.value() );
+        auto costs    = nlohmann::json::object();
+        for( const auto& cost: registry.entries() )
+          costs[ cost.name() ] = cost.compute();
+        return costs;
+      }
+    case tools::kernel_object::protocol_descriptor:
+      {
+        google::protobuf::FileDescriptorSet descriptors;
+        if( !descriptors.ParseFromString( entry.value() ) )
+          return raw_json( entry.value() );
+
+        auto files = nlohmann::json::object();
+        for( const auto& file: descriptors.file() )
+          files[ file.name() ] = {
+            {  "package",           file.package() },
+            { "messages", file.message_type_size() },
+            {    "enums",    file.enum_type_size() }
+          };
+
+        auto decoded       = raw_json( entry.value() );
+        decoded[ "files" ] = files;
+        return decoded;
+      }
+    case tools::kernel_object::block_hash_code:
+      {
+        google::protobuf::io::CodedInputStream input( reinterpret_cast< const uint8_t* >( entry.value().data() ),
+                                                      int( entry.value().size() ) );
+        uint64_t code = 0;
+        if( !input.ReadVarint64( &code ) )
+          return raw_json( entry.value() );
+        return code;
+      }
+  }
+
+  return raw_json( entry.value() );
+}
+
+// Entries indexed by space and key
+class entry_index
+{
+public:
+  static std::string index_key( const chain::genesis_entry& entry )
+  {
+    auto space = entry.space().SerializeAsString();
+
+    // The space is prefixed with its varint length so no two spaces and keys share an index key
+    uint8_t length[ 10 ];
+    auto length_end = google::protobuf::io::CodedOutputStream::WriteVarint64ToArray( space.size(), length );
+
+    std::string key;
+    key.reserve( ( length_end - length ) + space.size() + entry.key().size() );
+    key.append( reinterpret_cast< const char* >( length ), length_end - length );
+    key += space;
+    key += entry.key();
+    return key;
+  }
+
+  void insert( const chain::genesis_entry& entry )
+  {
+    _entries.insert_or_assign( index_key( entry ), entry );
+  }
+
+  // Remove and return the entry with the same space and key, if there is one
+  std::optional< chain::genesis_entry > take( const chain::genesis_entry& entry )
+  {
+    auto node = _entries.extract( index_key( entry ) );
+    if( node.empty() )
+      return {};
+
+    return std::move( node.mapped() );
+  }
+
+  std::size_t size() const
+  {
+    return _entries.size();
+  }
+
+  // Remaining entries in a stable order
+  std::vector< chain::genesis_entry > remaining() const
+  {
+    std::vector< std::pair< std::string, const chain::genesis_entry* > > sorted;
+    sorted.reserve( _entries.size() );
+    for( const auto& [ key, entry ]: _entries )
+      sorted.emplace_back( key, &entry );
+
+    std::sort( sorted.begin(), sorted.end() );
+
+    std::vector< chain::genesis_entry > entries;
+    entries.reserve( sorted.size() );
+    for( const auto& [ key, entry ]: sorted )
+      entries.push_back( *entry );
+
+    return entries;
+  }
+
+private:
+  std::unordered_map< std::string, chain::genesis_entry > _entries;
+};
+
+// Prints entries and differences as text or as one JSON object per line
+class diff_printer
+{
+public:
+  diff_printer( bool json ):
+      _json( json )
+  {}
+
+  void print( const chain::genesis_entry& entry )
+  {
+    if( _json )
+    {
+      nlohmann::json line = {
+        { "space", describe_space( entry.space() ) },
+        {   "key",             describe_key( entry ) },
+        { "value",             decode_value( entry ) }
+      };
+
+      std::cout << dump( line ) << '\n';
+    }
+    else
+    {
+      std::cout << describe_space( entry.space() ) << " " << describe_key( entry ) << ": "
+                << dump( decode_value( entry ) ) << '\n';
+    }
+  }
+
+  void added( const chain::genesis_entry& entry )
+  {
+    change( "added", entry, nullptr, decode_value( entry ) );
+  }
+
+  void removed( const chain::genesis_entry& entry )
+  {
+    change( "removed", entry, decode_value( entry ), nullptr );
+  }
+
+  void changed( const chain::genesis_entry& old_entry, const chain::genesis_entry& new_entry )
+  {
+    change( "changed", new_entry, decode_value( old_entry ), decode_value( new_entry ) );
+  }
+
+private:
+  void change( const std::string& kind,
+               const chain::genesis_entry& entry,
+               const nlohmann::json& old_value,
+               const nlohmann::json& new_value )
+  {
+    if( _json )
+    {
+      nlohmann::json line = {
+        { "change",                     kind },
+        {  "space", describe_space( entry.space() ) },
+        {    "key",         describe_key( entry ) }
+      };
+
+      if( !old_value.is_null() )
+        line[ "old" ] = old_value;
+      if( !new_value.is_null() )
+        line[ "new" ] = new_value;
+
+      std::cout << dump( line ) << '\n';
+      return;
+    }
+
+    auto prefix = kind == "added" ? '+' : kind == "removed" ? '-' : '~';
+    std::cout << prefix << " " << describe_space( entry.space() ) << " " << describe_key( entry );
+
+    if( kind == "added" )
+    {
+      std::cout << ": " << dump( new_value ) << '\n';
+    }
+    else if( kind == "removed" )
+    {
+      std::cout << ": " << dump( old_value ) << '\n';
+    }
+    else if( old_value.is_object() && new_value.is_object() )
+    {
+      // Show only the fields that differ
+      std::cout << '\n';
+      auto patch = nlohmann::json::diff( old_value, new_value );
+      for( const auto& operation: patch )
+      {
+        auto path = operation[ "path" ].get< std::string >();
+        auto old  = old_value.contains( nlohmann::json::json_pointer( path ) )
+                      ? dump( old_value[ nlohmann::json::json_pointer( path ) ] )
+                      : std::string( "(none)" );
+        auto now  = operation.contains( "value" ) ? dump( operation[ "value" ] ) : std::string( "(none)" );
+        std::cout << "    " << path.substr( 1 ) << ": " << old << " -> " << now << '\n';
+      }
+    }
+    else
+    {
+      std::cout << ": " << dump( old_value ) << " -> " << dump( new_value ) << '\n';
+    }
+  }
+
+  bool _json;
+};
+
+uint64_t read_file( const std::string& filename,
+                    tools::genesis_format format,
+                    const std::function< void( chain::genesis_entry& ) >& handler )
+{
+  if( filename == "-" )
+    return tools::read_genesis_entries( std::cin, format, handler );
+
+  std::ifstream stream( filename, std::ios::binary );
+  if( !stream )
+    throw std::runtime_error( "unable to open " + filename );
+
+  return tools::read_genesis_entries( stream, format, handler );
+}
+
+int main( int argc, char** argv )
+{
+  try
+  {
+    // Setup command line options
+    boost::program_options::options_description options( "Options" );
+    options.add_options()( HELP_OPTION "," HELP_FLAG, "print usage message" )(
+      FORMAT_OPTION "," FORMAT_FLAG,
+      boost::program_options::value< std::string >()->default_value( "auto" ),
+      "genesis file format, 'auto', 'json' or 'binary' (length delimited entries)" )(
+      JSON_OPTION "," JSON_FLAG,
+      "print one JSON object per line" );
+
+    tools::add_stats_options( options );
+
+    boost::program_options::options_description hidden( "Hidden options" );
+    hidden.add_options()( INPUT_OPTION, boost::program_options::value< std::vector< std::string > >() );
+
+    boost::program_options::options_description all_options;
+    all_options.add( options ).add( hidden );
+
+    boost::program_options::positional_options_description positional;
+    positional.add( INPUT_OPTION, 2 );
+
+    // Parse command-line options
+    boost::program_options::variables_map vm;
+    boost::program_options::store(
+      boost::program_options::command_line_parser( argc, argv ).options( all_options ).positional( positional ).run(),
+      vm );
+
+    // Handle help message
+    if( vm.count( HELP_OPTION ) || !vm.count( INPUT_OPTION ) )
+    {
+      std::cout << "Koinos Genesis Diff" << std::endl;
+      std::cout << "Usage: koinos_genesis_diff [options] <genesis> [<other genesis>]" << std::endl;
+      std::cout << "Prints the decoded entries of one genesis file, or the differences between two" << std::endl;
+      std::cout << "Exits with 0 when the files are the same, 1 when they differ and 2 on errors, as diff does"
+                << std::endl
+                << std::endl;
+      std::cout << options << std::endl;
+      return vm.count( HELP_OPTION ) ? EXIT_SUCCESS : EXIT_TROUBLE;
+    }
+
+    auto stats = tools::make_stats_reporter( vm, "koinos_genesis_diff" );
+
+    auto inputs = vm[ INPUT_OPTION ].as< std::vector< std::string > >();
+    auto format = tools::parse_genesis_format( vm[ FORMAT_OPTION ].as< std::string >() );
+    diff_printer printer( vm.count( JSON_OPTION ) );
+
+    if( inputs.size() == 1 )
+    {
+      read_file( inputs[ 0 ],
+                 format,
+                 [ & ]( chain::genesis_entry& entry )
+                 {
+                   printer.print( entry );
+                 } );
+
+      std::cout.flush();
+      return EXIT_SUCCESS;
+    }
+
+    auto start = std::chrono::steady_clock::now();
+
+    // Index the first file, then stream the second past it so only one file is ever held in memory
+    entry_index index;
+    auto old_count = read_file( inputs[ 0 ],
+                                format,
+                                [ & ]( chain::genesis_entry& entry )
+                                {
+                                  index.insert( entry );
+                                } );
+
+    uint64_t added = 0, removed = 0, changed = 0;
+    auto new_count = read_file( inputs[ 1 ],
+                                format,
+                                [ & ]( chain::genesis_entry& entry )
+                                {
+                                  auto old_entry = index.take( entry );
+
+                                  if( !old_entry )
+                                  {
+                                    added++;
+                                    printer.added( entry );
+                                  }
+                                  else if( old_entry->value() != entry.value() )
+                                  {
+                                    changed++;
+                                    printer.changed( *old_entry, entry );
+                                  }
+                                } );
+
+    for( const auto& entry: index.remaining() )
+    {
+      removed++;
+      printer.removed( entry );
+    }
+
+    std::cout.flush();
+
+    auto elapsed = std::chrono::duration< double >( std::chrono::steady_clock::now() - start ).count();
+    LOG( info ) << "Compared " << old_count << " and " << new_count << " entries in " << elapsed << "s: " << added
+                << " added, " << removed << " removed, " << changed << " changed";
+
+    return added + removed + changed ? EXIT_DIFFERENT : EXIT_SAME;
+  }
+  catch( const boost::exception& e )
+  {
+    LOG( fatal ) << boost::diagnostic_information( e ) << std::endl;
+  }
+  catch( const std::exception& e )
+  {
+    LOG( fatal ) << e.what() << std::endl;
+  }
+  catch( ... )
+  {
+    LOG( fatal ) << "unknown exception" << std::endl;
+  }
+
+  return EXIT_TROUBLE;
+}
@@ -1,7 +1,11 @@
+#include <chrono>
 #include <filesystem>
 #include <fstream>
 #include <iostream>
+#include <optional>
+#include <vector>
 
+#include <boost/algorithm/string.hpp>
 #include <boost/program_options.hpp>
 
 #include <koinos/crypto/elliptic.hpp>
@@ -9,6 +13,7 @@
 #include <koinos/exception.hpp>
 #include <koinos/log.hpp>
 #include <koinos/mq/client.hpp>
+#include <koinos/state_db/state_db.hpp>
 #include <koinos/util/base58.hpp>
 #include <koinos/util/conversion.hpp>
 #include <koinos/util/services.hpp>
@@ -20,59 +25,310 @@
 #include <google/protobuf/message.h>
 #include <google/protobuf/util/json_util.h>
 
+#include <koinos/tools/genesis.hpp>
+#include <koinos/tools/object_keys.hpp>
+#include <koinos/tools/ordered_executor.hpp>
+#include <koinos/tools/records.hpp>
+#include <koinos/tools/stats.hpp>
+
 #define HELP_OPTION "help"
 
+#define SPEC_OPTION "spec"
+#define SPEC_FLAG   "s"
+
+#define ACCOUNTS_OPTION "accounts"
+#define ACCOUNTS_FLAG   "a"
+
+#define ACCOUNTS_FORMAT_OPTION "accounts-format"
+
+#define TOKEN_CONTRACT_OPTION "token-contract"
+
+#define BALANCE_SPACE_OPTION "balance-space"
+
+#define OUTPUT_FORMAT_OPTION "output-format"
+#define OUTPUT_FORMAT_FLAG   "o"
+
+#define THREADS_OPTION "threads"
+#define THREADS_FLAG   "t"
+
+#define WRITE_STATE_DB_OPTION "write-state-db"
+
+// Accounts serialized per unit of work handed to a thread
+const std::size_t ACCOUNTS_PER_CHUNK = 1'024;
+
+// Chunks in flight per thread, bounding memory regardless of the number of accounts
+const std::size_t ACCOUNT_CHUNKS_PER_THREAD = 4;
+
+// A binary account record is a 25 byte address followed by a little endian uint64 balance
+const std::size_t ADDRESS_SIZE        = 25;
+const std::size_t BINARY_ACCOUNT_SIZE = ADDRESS_SIZE + 8;
+
 using namespace koinos;
 using namespace boost;
 
-namespace state {
+struct account_chunk
+{
+  std::vector< std::string > records;
+  std::vector< uint64_t > positions; // Line number or binary record index, for error messages
+};
+
+// Genesis entries produced together, serialized by the worker that produced them when writing to STDOUT
+struct entry_chunk
+{
+  std::vector< chain::genesis_entry > entries;
+  std::string serialized;
+};
+
+// A destination for genesis entries
+class entry_sink
+{
+public:
+  virtual ~entry_sink() = default;
+
+  // Prepare a chunk to be put, safe to call from many threads
+  virtual void prepare( entry_chunk& chunk ) const {}
+
+  // Put chunks in order, never called concurrently
+  virtual void put( entry_chunk& chunk ) = 0;
+
+  virtual void finish() {}
+};
+
+// Writes genesis entries to STDOUT as they are produced, either as the JSON of a genesis_data
+// message or as length delimited binary genesis_entry messages
+class entry_writer: public entry_sink
+{
+public:
+  entry_writer( bool binary ):
+      _binary( binary ),
+      _opts( tools::make_record_options( tools::record_format::binary, tools::record_format::binary ) )
+  {
+    if( !_binary )
+      std::cout << "{\"entries\":[";
+  }
+
+  void prepare( entry_chunk& chunk ) const override
+  {
+    std::string record;
+
+    for( const auto& entry: chunk.entries )
+    {
+      if( _binary )
+      {
+        tools::serialize_record( entry, _opts, record );
+      }
+      else
+      {
+        // Every entry is preceded by a separator, put() drops the first one
+        chunk.serialized.push_back( ',' );
+        record.clear();
+        google::protobuf::util::MessageToJsonString( entry, &record );
+      }
+
+      chunk.serialized += record;
+    }
+
+    chunk.entries.clear();
+  }
+
+  void put( entry_chunk& chunk ) override
+  {
+    if( chunk.serialized.empty() )
+      return;
+
+    tools::stage_timer timer( tools::stage::write );
+    tools::add_stage_bytes( tools::stage::write, chunk.serialized.size() );
+
+    if( !_binary && !_written )
+      std::cout.write( chunk.serialized.data() + 1, chunk.serialized.size() - 1 );
+    else
+      std::cout.write( chunk.serialized.data(), chunk.serialized.size() );
+
+    _written = true;
+  }
+
+  void finish() override
+  {
+    if( !_binary )
+      std::cout << "]}";
+
+    std::cout.flush();
+  }
+
+private:
+  bool _binary;
+  bool _written = false;
+  tools::record_options _opts;
+};
 
-namespace zone {
+// Puts genesis entries into the root state node of a state database
+class state_node_writer: public entry_sink
+{
+public:
+  state_node_writer( state_db::state_node_ptr root ):
+      _root( std::move( root ) )
+  {}
 
-const auto kernel = std::string{};
+  void put( entry_chunk& chunk ) override
+  {
+    for( const auto& entry: chunk.entries )
+      _root->put_object( entry.space(), entry.key(), &entry.value() );
 
-} // namespace zone
+    _count += chunk.entries.size();
+  }
 
-namespace space {
+  uint64_t count() const
+  {
+    return _count;
+  }
 
-const chain::object_space metadata()
+private:
+  state_db::state_node_ptr _root;
+  uint64_t _count = 0;
+};
+
+// Read the next chunk of account records, CSV lines or fixed size binary records
+bool read_accounts( std::istream& stream,
+                    bool binary,
+                    tools::record_reader& reader,
+                    uint64_t& position,
+                    account_chunk& chunk )
 {
-  chain::object_space s;
-  s.set_system( true );
-  s.set_zone( zone::kernel );
-  s.set_id( chain::system_space_id::metadata );
-  return s;
+  chunk.records.clear();
+  chunk.positions.clear();
+  chunk.records.reserve( ACCOUNTS_PER_CHUNK );
+  chunk.positions.reserve( ACCOUNTS_PER_CHUNK );
+
+  std::string record;
+  while( chunk.records.size() < ACCOUNTS_PER_CHUNK )
+  {
+    if( binary )
+    {
+      record.resize( BINARY_ACCOUNT_SIZE );
+      if( !stream.read( record.data(), record.size() ) )
+      {
+        if( stream.gcount() )
+          throw std::runtime_error( "truncated binary account record" );
+        break;
+      }
+
+      position++;
+    }
+    else
+    {
+      if( !reader.next( record ) )
+        break;
+
+      if( record.front() == '#' )
+        continue;
+
+      position = reader.position();
+    }
+
+    chunk.records.push_back( std::move( record ) );
+    chunk.positions.push_back( position );
+  }
+
+  return !chunk.records.empty();
 }
 
-} // namespace space
+// Create the balance entry, and nonce entry when a third column is present, for each account in the chunk
+entry_chunk make_account_entries( const account_chunk& chunk,
+                                  bool binary,
+                                  const std::string& token_contract,
+                                  uint32_t balance_space,
+                                  const entry_sink& sink )
+{
+  entry_chunk output;
+  output.entries.reserve( chunk.records.size() * 2 );
+  std::string address;
+  uint64_t balance = 0;
+  std::optional< uint64_t > nonce;
 
-namespace key {
+  for( std::size_t i = 0; i < chunk.records.size(); i++ )
+  {
+    const auto& record = chunk.records[ i ];
 
-const auto genesis_key = util::converter::as< std::string >(
-  crypto::hash( crypto::multicodec::sha2_256, std::string( "object_key::genesis_key" ) ) );
-const auto resource_limit_data = util::converter::as< std::string >(
-  crypto::hash( crypto::multicodec::sha2_256, std::string( "object_key::resource_limit_data" ) ) );
-const auto max_account_resources = util::converter::as< std::string >(
-  crypto::hash( crypto::multicodec::sha2_256, std::string( "object_key::max_account_resources" ) ) );
-const auto protocol_descriptor = util::converter::as< std::string >(
-  crypto::hash( crypto::multicodec::sha2_256, std::string( "object_key::protocol_descriptor" ) ) );
-const auto compute_bandwidth_registry = util::converter::as< std::string >(
-  crypto::hash( crypto::multicodec::sha2_256, std::string( "object_key::compute_bandwidth_registry" ) ) );
-const auto block_hash_code = util::converter::as< std::string >(
-  crypto::hash( crypto::multicodec::sha2_256, std::string( "object_key::block_hash_code" ) ) );
+    try
+    {
+      if( binary )
+      {
+        address = record.substr( 0, ADDRESS_SIZE );
+        balance = 0;
+        for( std::size_t b = 0; b < 8; b++ )
+          balance |= uint64_t( uint8_t( record[ ADDRESS_SIZE + b ] ) ) << ( 8 * b );
+      }
+      else
+      {
+        std::vector< std::string > fields;
+        boost::split( fields, record, boost::is_any_of( "," ) );
+        for( auto& field: fields )
+          boost::trim( field );
+
+        if( fields.size() < 2 || fields.size() > 3 )
+          throw std::runtime_error( "expected address,balance[,nonce]" );
+
+        // Skip a header row
+        if( fields[ 0 ] == "address" )
+          continue;
+
+        address = util::from_base58< std::string >( fields[ 0 ] );
+        balance = std::stoull( fields[ 1 ] );
+        nonce.reset();
+        if( fields.size() == 3 )
+          nonce = std::stoull( fields[ 2 ] );
+      }
+
+      if( address.size() != ADDRESS_SIZE )
+        throw std::runtime_error( "invalid address" );
+    }
+    catch( const std::exception& e )
+    {
+      throw std::runtime_error( "account record " + std::to_string( chunk.positions[ i ] ) + ": " + e.what() );
+    }
 
-} // namespace key
+    output.entries.push_back( tools::account_balance_entry( token_contract, balance_space, address, balance ) );
 
-} // namespace state
+    if( nonce )
+      output.entries.push_back( tools::account_nonce_entry( address, *nonce ) );
+  }
 
-chain::genesis_data default_genesis_data();
+  sink.prepare( output );
+  return output;
+}
 
 int main( int argc, char** argv )
 {
   try
   {
     program_options::options_description options( "Options" );
-    options.add_options()( HELP_OPTION ",h", "Print usage message" );
+    options.add_options()( HELP_OPTION ",h", "Print usage message" )(
+      SPEC_OPTION "," SPEC_FLAG,
+      program_options::value< std::string >(),
+      "Genesis spec file (YAML or JSON) to build genesis data from instead of the default" )(
+      ACCOUNTS_OPTION "," ACCOUNTS_FLAG,
+      program_options::value< std::string >(),
+      "Account list to pre-fund, CSV of address,balance[,nonce] or binary records, '-' for STDIN" )(
+      ACCOUNTS_FORMAT_OPTION,
+      program_options::value< std::string >()->default_value( "csv" ),
+      "Account list format, 'csv' or 'binary' (25 byte address and little endian uint64 balance)" )(
+      TOKEN_CONTRACT_OPTION,
+      program_options::value< std::string >(),
+      "Address of the token contract account balances are held in" )(
+      BALANCE_SPACE_OPTION,
+      program_options::value< uint32_t >()->default_value( 0 ),
+      "Object space id of balances in the token contract" )(
+      OUTPUT_FORMAT_OPTION "," OUTPUT_FORMAT_FLAG,
+      program_options::value< std::string >()->default_value( "json" ),
+      "Output format, 'json' (genesis_data) or 'binary' (length delimited genesis_entry messages)" )(
+      THREADS_OPTION "," THREADS_FLAG,
+      program_options::value< std::size_t >()->default_value( 0 ),
+      "Number of threads serializing account entries, 0 uses all cores" )(
+      WRITE_STATE_DB_OPTION,
+      program_options::value< std::string >(),
+      "Write genesis state into a new state database in this directory instead of printing it" );
+
+    tools::add_stats_options( options );
 
     program_options::variables_map args;
     program_options::store( program_options::parse_command_line( argc, argv, options ), args );
@@ -85,149 +341,120 @@ int main( int argc, char** argv )
       return EXIT_SUCCESS;
     }
 
-    chain::genesis_data gdata = default_genesis_data();
+    auto stats = tools::make_stats_reporter( args, "koinos_genesis_tool" );
+
+    chain::genesis_data gdata;
 
-    std::string out;
-    google::protobuf::util::MessageToJsonString( gdata, &out );
-    std::cout << out;
+    if( args.count( SPEC_OPTION ) )
+      gdata = tools::load_genesis_spec( args[ SPEC_OPTION ].as< std::string >() );
+    else
+      gdata = tools::default_genesis_data();
+
+    auto output_format = args[ OUTPUT_FORMAT_OPTION ].as< std::string >();
+    if( output_format != "json" && output_format != "binary" )
+      throw std::runtime_error( "unknown output format '" + output_format + "'" );
+
+    // Entries are put as they are produced so memory use does not grow with the number of accounts
+    auto put_entries = [ & ]( entry_sink& sink )
+    {
+      entry_chunk base;
+      base.entries.assign( gdata.entries().begin(), gdata.entries().end() );
+      sink.prepare( base );
+      sink.put( base );
+
+      if( !args.count( ACCOUNTS_OPTION ) )
+        return;
+
+      if( !args.count( TOKEN_CONTRACT_OPTION ) )
+        throw std::runtime_error( "--" TOKEN_CONTRACT_OPTION " is required with --" ACCOUNTS_OPTION );
+
+      auto token_contract  = util::from_base58< std::string >( args[ TOKEN_CONTRACT_OPTION ].as< std::string >() );
+      auto balance_space   = args[ BALANCE_SPACE_OPTION ].as< uint32_t >();
+      auto accounts_format = args[ ACCOUNTS_FORMAT_OPTION ].as< std::string >();
+      auto num_threads     = args[ THREADS_OPTION ].as< std::size_t >();
+
+      if( accounts_format != "csv" && accounts_format != "binary" )
+        throw std::runtime_error( "unknown accounts format '" + accounts_format + "'" );
+
+      if( !num_threads )
+        num_threads = tools::ordered_executor< account_chunk, entry_chunk >::default_concurrency();
+
+      bool binary_accounts = accounts_format == "binary";
+      auto accounts_file   = args[ ACCOUNTS_OPTION ].as< std::string >();
+
+      std::ifstream accounts_stream;
+      if( accounts_file != "-" )
+      {
+        accounts_stream.open( accounts_file, std::ios::binary );
+        if( !accounts_stream )
+          throw std::runtime_error( "unable to open " + accounts_file );
+      }
+
+      std::istream& input = accounts_file == "-" ? std::cin : accounts_stream;
+      tools::record_reader reader( tools::record_format::json, input );
+
+      tools::ordered_executor< account_chunk, entry_chunk > executor(
+        num_threads,
+        num_threads * ACCOUNT_CHUNKS_PER_THREAD,
+        [ & ]( account_chunk& chunk, std::size_t )
+        {
+          return make_account_entries( chunk, binary_accounts, token_contract, balance_space, sink );
+        },
+        [ & ]( entry_chunk& entries )
+        {
+          sink.put( entries );
+        } );
+
+      account_chunk chunk;
+      uint64_t position = 0;
+      while( read_accounts( input, binary_accounts, reader, position, chunk ) )
+      {
+        executor.push( std::move( chunk ) );
+        chunk = account_chunk();
+      }
+
+      executor.finish();
+    };
+
+    if( args.count( WRITE_STATE_DB_OPTION ) )
+    {
+      auto state_dir = std::filesystem::path( args[ WRITE_STATE_DB_OPTION ].as< std::string >() );
+
+      // Genesis is only applied to an empty database, an existing one would silently be left as is
+      if( std::filesystem::exists( state_dir ) && !std::filesystem::is_empty( state_dir ) )
+        throw std::runtime_error( "state directory " + state_dir.string() + " is not empty" );
+
+      uint64_t count = 0;
+      auto start     = std::chrono::steady_clock::now();
+
+      state_db::database db;
+      db.open(
+        state_dir,
+        [ & ]( state_db::state_node_ptr root )
+        {
+          state_node_writer sink( root );
+          put_entries( sink );
+          count = sink.count();
+        },
+        state_db::fork_resolution_algorithm::fifo,
+        db.get_unique_lock() );
+      db.close( db.get_unique_lock() );
+
+      auto elapsed = std::chrono::duration< double >( std::chrono::steady_clock::now() - start ).count();
+      LOG( info ) << "Wrote " << count << " genesis entries to " << state_dir.string() << " in " << elapsed << "s";
+    }
+    else
+    {
+      entry_writer writer( output_format == "binary" );
+      put_entries( writer );
+      writer.finish();
+    }
   }
   catch( const std::exception& e )
   {
     LOG( error ) << "Error: " << e.what();
+    return EXIT_FAILURE;
   }
 
   return EXIT_SUCCESS;
 }
-
-chain::genesis_data default_genesis_data()
-{
-  chain::genesis_data gdata;
-
-  crypto::private_key genesis_address =
-    crypto::private_key::from_wif( "5KYPA63Gx4MxQUqDM3PMckvX9nVYDUaLigTKAsLPesTyGmKmbR2" );
-
-  auto entry = gdata.add_entries();
-  entry->set_key( state::key::genesis_key );
-  entry->set_value( genesis_address.get_public_key().to_address_bytes() );
-  *entry->mutable_space() = state::space::metadata();
-
-  chain::resource_limit_data rd;
-
-  rd.set_disk_storage_cost( 10 );
-  rd.set_disk_storage_limit( 409'600 );
-
-  rd.set_network_bandwidth_cost( 5 );
-  rd.set_network_bandwidth_limit( 1'048'576 );
-
-  rd.set_compute_bandwidth_cost( 1 );
-  rd.set_compute_bandwidth_limit( 100'000'000 );
-
-  entry = gdata.add_entries();
-  entry->set_key( state::key::resource_limit_data );
-  entry->set_value( util::converter::as< std::string >( rd ) );
-  *entry->mutable_space() = state::space::metadata();
-
-  chain::max_account_resources mar;
-
-  mar.set_value( 10'000'000 );
-
-  entry = gdata.add_entries();
-  entry->set_key( state::key::max_account_resources );
-  entry->set_value( util::converter::as< std::string >( mar ) );
-  *entry->mutable_space() = state::space::metadata();
-
-  entry = gdata.add_entries();
-  entry->set_key( state::key::protocol_descriptor );
-
-  // protoc --experimental_allow_proto3_optional --descriptor_set_out=build/koinos_protocol.pb --include_imports `find
-  // koinos -name 'protocol.proto'`
-  std::string protocol_descriptor = util::from_hex< std::string >(
-    "0x0ac33b0a20676f6f676c652f70726f746f6275662f64657363726970746f722e70726f746f120f676f6f676c652e70726f746f627566224d0a1146696c6544657363726970746f7253657412380a0466696c6518012003280b32242e676f6f676c652e70726f746f6275662e46696c6544657363726970746f7250726f746f520466696c6522e4040a1346696c6544657363726970746f7250726f746f12120a046e616d6518012001280952046e616d6512180a077061636b61676518022001280952077061636b616765121e0a0a646570656e64656e6379180320032809520a646570656e64656e6379122b0a117075626c69635f646570656e64656e6379180a2003280552107075626c6963446570656e64656e637912270a0f7765616b5f646570656e64656e6379180b20032805520e7765616b446570656e64656e637912430a0c6d6573736167655f7479706518042003280b32202e676f6f676c652e70726f746f6275662e44657363726970746f7250726f746f520b6d6573736167655479706512410a09656e756d5f7479706518052003280b32242e676f6f676c652e70726f746f6275662e456e756d44657363726970746f7250726f746f5208656e756d5479706512410a077365727669636518062003280b32272e676f6f676c652e70726f746f6275662e5365727669636544657363726970746f7250726f746f52077365727669636512430a09657874656e73696f6e18072003280b32252e676f6f676c652e70726f746f6275662e4669656c6444657363726970746f7250726f746f5209657874656e73696f6e12360a076f7074696f6e7318082001280b321c2e676f6f676c652e70726f746f6275662e46696c654f7074696f6e7352076f7074696f6e7312490a10736f757263655f636f64655f696e666f18092001280b321f2e676f6f676c652e70726f746f6275662e536f75726365436f6465496e666f520e736f75726365436f6465496e666f12160a0673796e746178180c20012809520673796e74617822b9060a0f44657363726970746f7250726f746f12120a046e616d6518012001280952046e616d65123b0a056669656c6418022003280b32252e676f6f676c652e70726f746f6275662e4669656c6444657363726970746f7250726f746f52056669656c6412430a09657874656e73696f6e18062003280b32252e676f6f676c652e70726f746f6275662e4669656c6444657363726970746f7250726f746f5209657874656e73696f6e12410a0b6e65737465645f7479706518032003280b32202e676f6f676c652e70726f746f6275662e44657363726970746f7250726f746f520a6e65737465645479706512410a09656e756d5f7479706518042003280b32242e676f6f676c652e70726f746f6275662e456e756d44657363726970746f7250726f746f5208656e756d5479706512580a0f657874656e73696f6e5f72616e676518052003280b322f2e676f6f676c652e70726f746f6275662e44657363726970746f7250726f746f2e457874656e73696f6e52616e6765520e657874656e73696f6e52616e676512440a0a6f6e656f665f6465636c18082003280b32252e676f6f676c652e70726f746f6275662e4f6e656f6644657363726970746f7250726f746f52096f6e656f664465636c12390a076f7074696f6e7318072001280b321f2e676f6f676c652e70726f746f6275662e4d6573736167654f7074696f6e7352076f7074696f6e7312550a0e72657365727665645f72616e676518092003280b322e2e676f6f676c652e70726f746f6275662e44657363726970746f7250726f746f2e526573657276656452616e6765520d726573657276656452616e676512230a0d72657365727665645f6e616d65180a20032809520c72657365727665644e616d651a7a0a0e457874656e73696f6e52616e676512140a0573746172741801200128055205737461727412100a03656e641802200128055203656e6412400a076f7074696f6e7318032001280b32262e676f6f676c652e70726f746f6275662e457874656e73696f6e52616e67654f7074696f6e7352076f7074696f6e731a370a0d526573657276656452616e676512140a0573746172741801200128055205737461727412100a03656e641802200128055203656e64227c0a15457874656e73696f6e52616e67654f7074696f6e7312580a14756e696e7465727072657465645f6f7074696f6e18e7072003280b32242e676f6f676c652e70726f746f6275662e556e696e7465727072657465644f7074696f6e5213756e696e7465727072657465644f7074696f6e2a0908e80710808080800222c1060a144669656c6444657363726970746f7250726f746f12120a046e616d6518012001280952046e616d6512160a066e756d62657218032001280552066e756d62657212410a056c6162656c18042001280e322b2e676f6f676c652e70726f746f6275662e4669656c6444657363726970746f7250726f746f2e4c6162656c52056c6162656c123e0a047479706518052001280e322a2e676f6f676c652e70726f746f6275662e4669656c6444657363726970746f7250726f746f2e54797065520474797065121b0a09747970655f6e616d651806200128095208747970654e616d65121a0a08657874656e6465651802200128095208657874656e64656512230a0d64656661756c745f76616c7565180720012809520c64656661756c7456616c7565121f0a0b6f6e656f665f696e646578180920012805520a6f6e656f66496e646578121b0a096a736f6e5f6e616d65180a2001280952086a736f6e4e616d6512370a076f7074696f6e7318082001280b321d2e676f6f676c652e70726f746f6275662e4669656c644f7074696f6e7352076f7074696f6e7312270a0f70726f746f335f6f7074696f6e616c181120012808520e70726f746f334f7074696f6e616c22b6020a0454797065120f0a0b545950455f444f55424c451001120e0a0a545950455f464c4f41541002120e0a0a545950455f494e5436341003120f0a0b545950455f55494e5436341004120e0a0a545950455f494e543332100512100a0c545950455f46495845443634100612100a0c545950455f464958454433321007120d0a09545950455f424f4f4c1008120f0a0b545950455f535452494e471009120e0a0a545950455f47524f5550100a12100a0c545950455f4d455353414745100b120e0a0a545950455f4259544553100c120f0a0b545950455f55494e543332100d120d0a09545950455f454e554d100e12110a0d545950455f5346495845443332100f12110a0d545950455f53464958454436341010120f0a0b545950455f53494e5433321011120f0a0b545950455f53494e543634101222430a054c6162656c12120a0e4c4142454c5f4f5054494f4e414c100112120a0e4c4142454c5f5245515549524544100212120a0e4c4142454c5f5245504541544544100322630a144f6e656f6644657363726970746f7250726f746f12120a046e616d6518012001280952046e616d6512370a076f7074696f6e7318022001280b321d2e676f6f676c652e70726f746f6275662e4f6e656f664f7074696f6e7352076f7074696f6e7322e3020a13456e756d44657363726970746f7250726f746f12120a046e616d6518012001280952046e616d65123f0a0576616c756518022003280b32292e676f6f676c652e70726f746f6275662e456e756d56616c756544657363726970746f7250726f746f520576616c756512360a076f7074696f6e7318032001280b321c2e676f6f676c652e70726f746f6275662e456e756d4f7074696f6e7352076f7074696f6e73125d0a0e72657365727665645f72616e676518042003280b32362e676f6f676c652e70726f746f6275662e456e756d44657363726970746f7250726f746f2e456e756d526573657276656452616e6765520d726573657276656452616e676512230a0d72657365727665645f6e616d65180520032809520c72657365727665644e616d651a3b0a11456e756d526573657276656452616e676512140a0573746172741801200128055205737461727412100a03656e641802200128055203656e642283010a18456e756d56616c756544657363726970746f7250726f746f12120a046e616d6518012001280952046e616d6512160a066e756d62657218022001280552066e756d626572123b0a076f7074696f6e7318032001280b32212e676f6f676c652e70726f746f6275662e456e756d56616c75654f7074696f6e7352076f7074696f6e7322a7010a165365727669636544657363726970746f7250726f746f12120a046e616d6518012001280952046e616d65123e0a066d6574686f6418022003280b32262e676f6f676c652e70726f746f6275662e4d6574686f6444657363726970746f7250726f746f52066d6574686f6412390a076f7074696f6e7318032001280b321f2e676f6f676c652e70726f746f6275662e536572766963654f7074696f6e7352076f7074696f6e732289020a154d6574686f6444657363726970746f7250726f746f12120a046e616d6518012001280952046e616d65121d0a0a696e7075745f747970651802200128095209696e70757454797065121f0a0b6f75747075745f74797065180320012809520a6f75747075745479706512380a076f7074696f6e7318042001280b321e2e676f6f676c652e70726f746f6275662e4d6574686f644f7074696f6e7352076f7074696f6e7312300a10636c69656e745f73747265616d696e671805200128083a0566616c7365520f636c69656e7453747265616d696e6712300a107365727665725f73747265616d696e671806200128083a0566616c7365520f73657276657253747265616d696e672291090a0b46696c654f7074696f6e7312210a0c6a6176615f7061636b616765180120012809520b6a6176615061636b61676512300a146a6176615f6f757465725f636c6173736e616d6518082001280952126a6176614f75746572436c6173736e616d6512350a136a6176615f6d756c7469706c655f66696c6573180a200128083a0566616c736552116a6176614d756c7469706c6546696c657312440a1d6a6176615f67656e65726174655f657175616c735f616e645f686173681814200128084202180152196a61766147656e6572617465457175616c73416e6448617368123a0a166a6176615f737472696e675f636865636b5f75746638181b200128083a0566616c736552136a617661537472696e67436865636b5574663812530a0c6f7074696d697a655f666f7218092001280e32292e676f6f676c652e70726f746f6275662e46696c654f7074696f6e732e4f7074696d697a654d6f64653a055350454544520b6f7074696d697a65466f72121d0a0a676f5f7061636b616765180b200128095209676f5061636b61676512350a1363635f67656e657269635f73657276696365731810200128083a0566616c73655211636347656e65726963536572766963657312390a156a6176615f67656e657269635f73657276696365731811200128083a0566616c736552136a61766147656e65726963536572766963657312350a1370795f67656e657269635f73657276696365731812200128083a0566616c73655211707947656e65726963536572766963657312370a147068705f67656e657269635f7365727669636573182a200128083a0566616c7365521270687047656e65726963536572766963657312250a0a646570726563617465641817200128083a0566616c7365520a64657072656361746564122e0a1063635f656e61626c655f6172656e6173181f200128083a0474727565520e6363456e61626c654172656e6173122a0a116f626a635f636c6173735f707265666978182420012809520f6f626a63436c61737350726566697812290a106373686172705f6e616d657370616365182520012809520f6373686172704e616d65737061636512210a0c73776966745f707265666978182720012809520b737769667450726566697812280a107068705f636c6173735f707265666978182820012809520e706870436c61737350726566697812230a0d7068705f6e616d657370616365182920012809520c7068704e616d65737061636512340a167068705f6d657461646174615f6e616d657370616365182c2001280952147068704d657461646174614e616d65737061636512210a0c727562795f7061636b616765182d20012809520b727562795061636b61676512580a14756e696e7465727072657465645f6f7074696f6e18e7072003280b32242e676f6f676c652e70726f746f6275662e556e696e7465727072657465644f7074696f6e5213756e696e7465727072657465644f7074696f6e223a0a0c4f7074696d697a654d6f646512090a0553504545441001120d0a09434f44455f53495a45100212100a0c4c4954455f52554e54494d4510032a0908e8071080808080024a040826102722e3020a0e4d6573736167654f7074696f6e73123c0a176d6573736167655f7365745f776972655f666f726d61741801200128083a0566616c736552146d65737361676553657457697265466f726d6174124c0a1f6e6f5f7374616e646172645f64657363726970746f725f6163636573736f721802200128083a0566616c7365521c6e6f5374616e6461726444657363726970746f724163636573736f7212250a0a646570726563617465641803200128083a0566616c7365520a64657072656361746564121b0a096d61705f656e74727918072001280852086d6170456e74727912580a14756e696e7465727072657465645f6f7074696f6e18e7072003280b32242e676f6f676c652e70726f746f6275662e556e696e7465727072657465644f7074696f6e5213756e696e7465727072657465644f7074696f6e2a0908e8071080808080024a04080410054a04080510064a04080610074a04080810094a040809100a22e2030a0c4669656c644f7074696f6e7312410a05637479706518012001280e32232e676f6f676c652e70726f746f6275662e4669656c644f7074696f6e732e43547970653a06535452494e475205637479706512160a067061636b656418022001280852067061636b656412470a066a737479706518062001280e32242e676f6f676c652e70726f746f6275662e4669656c644f7074696f6e732e4a53547970653a094a535f4e4f524d414c52066a737479706512190a046c617a791805200128083a0566616c736552046c617a7912250a0a646570726563617465641803200128083a0566616c7365520a6465707265636174656412190a047765616b180a200128083a0566616c736552047765616b12580a14756e696e7465727072657465645f6f7074696f6e18e7072003280b32242e676f6f676c652e70726f746f6275662e556e696e7465727072657465644f7074696f6e5213756e696e7465727072657465644f7074696f6e222f0a054354797065120a0a06535452494e47100012080a04434f5244100112100a0c535452494e475f5049454345100222350a064a5354797065120d0a094a535f4e4f524d414c1000120d0a094a535f535452494e471001120d0a094a535f4e554d42455210022a0908e8071080808080024a040804100522730a0c4f6e656f664f7074696f6e7312580a14756e696e7465727072657465645f6f7074696f6e18e7072003280b32242e676f6f676c652e70726f746f6275662e556e696e7465727072657465644f7074696f6e5213756e696e7465727072657465644f7074696f6e2a0908e80710808080800222c0010a0b456e756d4f7074696f6e73121f0a0b616c6c6f775f616c696173180220012808520a616c6c6f77416c69617312250a0a646570726563617465641803200128083a0566616c7365520a6465707265636174656412580a14756e696e7465727072657465645f6f7074696f6e18e7072003280b32242e676f6f676c652e70726f746f6275662e556e696e7465727072657465644f7074696f6e5213756e696e7465727072657465644f7074696f6e2a0908e8071080808080024a0408051006229e010a10456e756d56616c75654f7074696f6e7312250a0a646570726563617465641801200128083a0566616c7365520a6465707265636174656412580a14756e696e7465727072657465645f6f7074696f6e18e7072003280b32242e676f6f676c652e70726f746f6275662e556e696e7465727072657465644f7074696f6e5213756e696e7465727072657465644f7074696f6e2a0908e807108080808002229c010a0e536572766963654f7074696f6e7312250a0a646570726563617465641821200128083a0566616c7365520a6465707265636174656412580a14756e696e7465727072657465645f6f7074696f6e18e7072003280b32242e676f6f676c652e70726f746f6275662e556e696e7465727072657465644f7074696f6e5213756e696e7465727072657465644f7074696f6e2a0908e80710808080800222e0020a0d4d6574686f644f7074696f6e7312250a0a646570726563617465641821200128083a0566616c7365520a6465707265636174656412710a116964656d706f74656e63795f6c6576656c18222001280e322f2e676f6f676c652e70726f746f6275662e4d6574686f644f7074696f6e732e4964656d706f74656e63794c6576656c3a134944454d504f54454e43595f554e4b4e4f574e52106964656d706f74656e63794c6576656c12580a14756e696e7465727072657465645f6f7074696f6e18e7072003280b32242e676f6f676c652e70726f746f6275662e556e696e7465727072657465644f7074696f6e5213756e696e7465727072657465644f7074696f6e22500a104964656d706f74656e63794c6576656c12170a134944454d504f54454e43595f554e4b4e4f574e100012130a0f4e4f5f534944455f454646454354531001120e0a0a4944454d504f54454e5410022a0908e807108080808002229a030a13556e696e7465727072657465644f7074696f6e12410a046e616d6518022003280b322d2e676f6f676c652e70726f746f6275662e556e696e7465727072657465644f7074696f6e2e4e616d655061727452046e616d6512290a106964656e7469666965725f76616c7565180320012809520f6964656e74696669657256616c7565122c0a12706f7369746976655f696e745f76616c75651804200128045210706f736974697665496e7456616c7565122c0a126e656761746976655f696e745f76616c756518052001280352106e65676174697665496e7456616c756512210a0c646f75626c655f76616c7565180620012801520b646f75626c6556616c756512210a0c737472696e675f76616c756518072001280c520b737472696e6756616c756512270a0f6167677265676174655f76616c7565180820012809520e61676772656761746556616c75651a4a0a084e616d6550617274121b0a096e616d655f7061727418012002280952086e616d655061727412210a0c69735f657874656e73696f6e180220022808520b6973457874656e73696f6e22a7020a0e536f75726365436f6465496e666f12440a086c6f636174696f6e18012003280b32282e676f6f676c652e70726f746f6275662e536f75726365436f6465496e666f2e4c6f636174696f6e52086c6f636174696f6e1ace010a084c6f636174696f6e12160a04706174681801200328054202100152047061746812160a047370616e1802200328054202100152047370616e12290a106c656164696e675f636f6d6d656e7473180320012809520f6c656164696e67436f6d6d656e7473122b0a11747261696c696e675f636f6d6d656e74731804200128095210747261696c696e67436f6d6d656e7473123a0a196c656164696e675f64657461636865645f636f6d6d656e747318062003280952176c656164696e674465746163686564436f6d6d656e747322d1010a1147656e657261746564436f6465496e666f124d0a0a616e6e6f746174696f6e18012003280b322d2e676f6f676c652e70726f746f6275662e47656e657261746564436f6465496e666f2e416e6e6f746174696f6e520a616e6e6f746174696f6e1a6d0a0a416e6e6f746174696f6e12160a047061746818012003280542021001520470617468121f0a0b736f757263655f66696c65180220012809520a736f7572636546696c6512140a05626567696e1803200128055205626567696e12100a03656e641804200128055203656e64427e0a13636f6d2e676f6f676c652e70726f746f627566421044657363726970746f7250726f746f7348015a2d676f6f676c652e676f6c616e672e6f72672f70726f746f6275662f74797065732f64657363726970746f727062f80101a20203475042aa021a476f6f676c652e50726f746f6275662e5265666c656374696f6e0ab5020a146b6f696e6f732f6f7074696f6e732e70726f746f12066b6f696e6f731a20676f6f676c652f70726f746f6275662f64657363726970746f722e70726f746f2a6d0a0a62797465735f74797065120a0a064241534536341000120a0a06424153453538100112070a034845581002120c0a08424c4f434b5f4944100312120a0e5452414e53414354494f4e5f49441004120f0a0b434f4e54524143545f49441005120b0a074144445245535310063a4c0a056274797065121d2e676f6f676c652e70726f746f6275662e4669656c644f7074696f6e7318d086032001280e32122e6b6f696e6f732e62797465735f7479706552056274797065880101422e5a2c6769746875622e636f6d2f6b6f696e6f732f6b6f696e6f732d70726f746f2d676f6c616e672f6b6f696e6f73620670726f746f330a851a0a1e6b6f696e6f732f70726f746f636f6c2f70726f746f636f6c2e70726f746f120f6b6f696e6f732e70726f746f636f6c1a146b6f696e6f732f6f7074696f6e732e70726f746f2290010a0a6576656e745f64617461121a0a0873657175656e636518012001280d520873657175656e6365121c0a06736f7572636518022001280c420480b518055206736f7572636512120a046e616d6518032001280952046e616d6512120a046461746118042001280c52046461746112200a08696d70616374656418052003280c420480b518065208696d706163746564225e0a14636f6e74726163745f63616c6c5f62756e646c6512250a0b636f6e74726163745f696418012001280c420480b51805520a636f6e74726163744964121f0a0b656e7472795f706f696e7418022001280d520a656e747279506f696e742292010a1273797374656d5f63616c6c5f746172676574121b0a087468756e6b5f696418012001280d480052077468756e6b496412550a1273797374656d5f63616c6c5f62756e646c6518022001280b32252e6b6f696e6f732e70726f746f636f6c2e636f6e74726163745f63616c6c5f62756e646c654800521073797374656d43616c6c42756e646c6542080a0674617267657422b6020a1975706c6f61645f636f6e74726163745f6f7065726174696f6e12250a0b636f6e74726163745f696418012001280c420480b51805520a636f6e74726163744964121a0a0862797465636f646518022001280c520862797465636f646512100a03616269180320012809520361626912380a18617574686f72697a65735f63616c6c5f636f6e74726163741804200128085216617574686f72697a657343616c6c436f6e7472616374124c0a22617574686f72697a65735f7472616e73616374696f6e5f6170706c69636174696f6e1805200128085220617574686f72697a65735472616e73616374696f6e4170706c69636174696f6e123c0a1a617574686f72697a65735f75706c6f61645f636f6e74726163741806200128085218617574686f72697a657355706c6f6164436f6e747261637422750a1763616c6c5f636f6e74726163745f6f7065726174696f6e12250a0b636f6e74726163745f696418012001280c420480b51805520a636f6e74726163744964121f0a0b656e7472795f706f696e7418022001280d520a656e747279506f696e7412120a046172677318032001280c52046172677322710a197365745f73797374656d5f63616c6c5f6f7065726174696f6e12170a0763616c6c5f696418012001280d520663616c6c4964123b0a0674617267657418022001280b32232e6b6f696e6f732e70726f746f636f6c2e73797374656d5f63616c6c5f7461726765745206746172676574226f0a1d7365745f73797374656d5f636f6e74726163745f6f7065726174696f6e12250a0b636f6e74726163745f696418012001280c420480b51805520a636f6e7472616374496412270a0f73797374656d5f636f6e7472616374180220012808520e73797374656d436f6e747261637422f1020a096f7065726174696f6e12550a0f75706c6f61645f636f6e747261637418012001280b322a2e6b6f696e6f732e70726f746f636f6c2e75706c6f61645f636f6e74726163745f6f7065726174696f6e4800520e75706c6f6164436f6e7472616374124f0a0d63616c6c5f636f6e747261637418022001280b32282e6b6f696e6f732e70726f746f636f6c2e63616c6c5f636f6e74726163745f6f7065726174696f6e4800520c63616c6c436f6e747261637412540a0f7365745f73797374656d5f63616c6c18032001280b322a2e6b6f696e6f732e70726f746f636f6c2e7365745f73797374656d5f63616c6c5f6f7065726174696f6e4800520d73657453797374656d43616c6c12600a137365745f73797374656d5f636f6e747261637418042001280b322e2e6b6f696e6f732e70726f746f636f6c2e7365745f73797374656d5f636f6e74726163745f6f7065726174696f6e4800521173657453797374656d436f6e747261637442040a026f7022d0010a127472616e73616374696f6e5f68656164657212190a08636861696e5f696418012001280c5207636861696e4964121d0a0872635f6c696d697418022001280442023001520772634c696d697412140a056e6f6e636518032001280c52056e6f6e636512320a156f7065726174696f6e5f6d65726b6c655f726f6f7418042001280c52136f7065726174696f6e4d65726b6c65526f6f74121a0a05706179657218052001280c420480b5180652057061796572121a0a05706179656518062001280c420480b518065205706179656522bc010a0b7472616e73616374696f6e12140a02696418012001280c420480b5180452026964123b0a0668656164657218022001280b32232e6b6f696e6f732e70726f746f636f6c2e7472616e73616374696f6e5f6865616465725206686561646572123a0a0a6f7065726174696f6e7318032003280b321a2e6b6f696e6f732e70726f746f636f6c2e6f7065726174696f6e520a6f7065726174696f6e73121e0a0a7369676e61747572657318042003280c520a7369676e61747572657322b2030a137472616e73616374696f6e5f7265636569707412140a02696418012001280c420480b5180452026964121a0a05706179657218022001280c420480b518065205706179657212240a0c6d61785f70617965725f726318032001280442023001520a6d617850617965725263121d0a0872635f6c696d697418042001280442023001520772634c696d6974121b0a0772635f75736564180520012804420230015206726355736564122e0a116469736b5f73746f726167655f7573656418062001280442023001520f6469736b53746f726167655573656412380a166e6574776f726b5f62616e6477696474685f757365641807200128044202300152146e6574776f726b42616e6477696474685573656412380a16636f6d707574655f62616e6477696474685f75736564180820012804420230015214636f6d7075746542616e64776964746855736564121a0a0872657665727465641809200128085208726576657274656412330a066576656e7473180a2003280b321b2e6b6f696e6f732e70726f746f636f6c2e6576656e745f6461746152066576656e747312120a046c6f6773180b2003280952046c6f677322b6020a0c626c6f636b5f68656164657212200a0870726576696f757318012001280c420480b51803520870726576696f7573121a0a0668656967687418022001280442023001520668656967687412200a0974696d657374616d7018032001280442023001520974696d657374616d70123b0a1a70726576696f75735f73746174655f6d65726b6c655f726f6f7418042001280c521770726576696f757353746174654d65726b6c65526f6f7412360a177472616e73616374696f6e5f6d65726b6c655f726f6f7418052001280c52157472616e73616374696f6e4d65726b6c65526f6f74121c0a067369676e657218062001280c420480b5180652067369676e657212330a12617070726f7665645f70726f706f73616c7318072003280c420480b518045211617070726f76656450726f706f73616c7322b4010a05626c6f636b12140a02696418012001280c420480b518035202696412350a0668656164657218022001280b321d2e6b6f696e6f732e70726f746f636f6c2e626c6f636b5f686561646572520668656164657212400a0c7472616e73616374696f6e7318032003280b321c2e6b6f696e6f732e70726f746f636f6c2e7472616e73616374696f6e520c7472616e73616374696f6e73121c0a097369676e617475726518042001280c52097369676e617475726522b3030a0d626c6f636b5f7265636569707412140a02696418012001280c420480b5180352026964121a0a06686569676874180220012804420230015206686569676874122e0a116469736b5f73746f726167655f7573656418032001280442023001520f6469736b53746f726167655573656412380a166e6574776f726b5f62616e6477696474685f757365641804200128044202300152146e6574776f726b42616e6477696474685573656412380a16636f6d707574655f62616e6477696474685f75736564180520012804420230015214636f6d7075746542616e64776964746855736564122a0a1173746174655f6d65726b6c655f726f6f7418062001280c520f73746174654d65726b6c65526f6f7412330a066576656e747318072003280b321b2e6b6f696e6f732e70726f746f636f6c2e6576656e745f6461746152066576656e747312570a147472616e73616374696f6e5f726563656970747318082003280b32242e6b6f696e6f732e70726f746f636f6c2e7472616e73616374696f6e5f7265636569707452137472616e73616374696f6e526563656970747312120a046c6f677318092003280952046c6f677342375a356769746875622e636f6d2f6b6f696e6f732f6b6f696e6f732d70726f746f2d676f6c616e672f6b6f696e6f732f70726f746f636f6c620670726f746f33" );
-  entry->set_value( protocol_descriptor );
-  *entry->mutable_space() = state::space::metadata();
-
-  std::map< std::string, uint64_t > thunk_compute{
-    {                        "apply_block",  16'659},
-    {      "apply_call_contract_operation",     487},
-    {    "apply_set_system_call_operation",   5'986},
-    {"apply_set_system_contract_operation",   4'746},
-    {                  "apply_transaction",  13'208},
-    {    "apply_upload_contract_operation",   3'722},
-    {                      "call_contract",   4'810},
-    {                 "consume_account_rc",     734},
-    {            "consume_block_resources",     729},
-    {       "deserialize_message_per_byte",       1},
-    {         "deserialize_multihash_base",       1},
-    {     "deserialize_multihash_per_byte",     478},
-    {                              "event",   1'361},
-    {                 "event_per_impacted",      98},
-    {                      "exit_contract",  10'246},
-    {                  "get_account_nonce",     768},
-    {                     "get_account_rc",   1'046},
-    {                          "get_block",   1'131},
-    {                    "get_block_field",   1'420},
-    {                         "get_caller",     818},
-    {             "get_contract_arguments",     770},
-    {                    "get_contract_id",     774},
-    {                    "get_entry_point",     756},
-    {                      "get_head_info",   2'160},
-    {        "get_last_irreversible_block",     759},
-    {                    "get_next_object",  11'071},
-    {                         "get_object",   1'067},
-    {                    "get_prev_object",  15'633},
-    {                "get_resource_limits",   1'153},
-    {                    "get_transaction",   1'619},
-    {              "get_transaction_field",   1'518},
-    {                               "hash",   1'573},
-    {                    "keccak_256_base",   1'945},
-    {                "keccak_256_per_byte",       1},
-    {                                "log",     746},
-    {      "object_serialization_per_byte",       1},
-    {                "post_block_callback",     724},
-    {          "post_transaction_callback",     741},
-    {                 "pre_block_callback",     722},
-    {           "pre_transaction_callback",     718},
-    {            "process_block_signature",   5'085},
-    {                         "put_object",   1'053},
-    {                 "recover_public_key",  29'531},
-    {                      "remove_object",     908},
-    {                  "require_authority",  13'295},
-    {           "require_system_authority",  13'357},
-    {                    "ripemd_160_base",   1'596},
-    {                "ripemd_160_per_byte",       1},
-    {                  "set_account_nonce",     753},
-    {                "set_contract_result",     753},
-    {                          "sha1_base",   1'137},
-    {                      "sha1_per_byte",       1},
-    {                      "sha2_256_base",   1'542},
-    {                  "sha2_256_per_byte",       1},
-    {                      "sha2_512_base",   1'612},
-    {                  "sha2_512_per_byte",       1},
-    {               "verify_account_nonce",     879},
-    {                 "verify_merkle_root",       1},
-    {                   "verify_signature",     794},
-    {                   "verify_vrf_proof", 143'804},
-  };
-
-  chain::compute_bandwidth_registry cbr;
-
-  for( const auto& [ key, value ]: thunk_compute )
-  {
-    auto centry = cbr.add_entries();
-    centry->set_name( key );
-    centry->set_compute( value );
-  }
-
-  entry = gdata.add_entries();
-  entry->set_key( state::key::compute_bandwidth_registry );
-  entry->set_value( util::converter::as< std::string >( cbr ) );
-  *entry->mutable_space() = state::space::metadata();
-
-  entry = gdata.add_entries();
-  entry->set_key( state::key::block_hash_code );
-  entry->set_value( util::converter::as< std::string >(
-    unsigned_varint{ std::underlying_type_t< crypto::multicodec >( crypto::multicodec::sha2_256 ) } ) );
-  *entry->mutable_space() = state::space::metadata();
-
-  return gdata;
-}
@@ -1,15 +1,21 @@
+#include <algorithm>
+#include <chrono>
 #include <fstream>
 #include <iostream>
+#include <optional>
 
 #include <boost/program_options.hpp>
 
 #include <koinos/crypto/elliptic.hpp>
-#include <koinos/crypto/multihash.hpp>
 #include <koinos/exception.hpp>
 #include <koinos/log.hpp>
 #include <koinos/util/base58.hpp>
 #include <koinos/util/random.hpp>
 
+#include <koinos/tools/keystore.hpp>
+#include <koinos/tools/ordered_executor.hpp>
+#include <koinos/tools/stats.hpp>
+
 // Command line option definitions
 #define HELP_OPTION "help"
 #define HELP_FLAG   "h"
@@ -25,6 +31,78 @@ const uint64_t NUM_KEYS_DEFAULT = 1;
 #define OUTPUT_FILE_FLAG   "o"
 const std::string OUTPUT_FILE_DEFAULT = "private.key";
 
+#define THREADS_OPTION "threads"
+#define THREADS_FLAG   "t"
+
+#define QUIET_OPTION "quiet"
+#define QUIET_FLAG   "q"
+
+#define FORMAT_OPTION "format"
+#define FORMAT_FLAG   "f"
+const std::string FORMAT_WIF      = "wif";
+const std::string FORMAT_KEYSTORE = "keystore";
+
+#define LOOKUP_OPTION "lookup"
+#define LOOKUP_FLAG   "l"
+
+// Keys generated per unit of work handed to a thread
+const uint64_t KEYS_PER_CHUNK = 256;
+
+// Keys generated for a contiguous range of indices
+struct key_chunk
+{
+  std::string wifs;
+  std::vector< koinos::crypto::private_key > keys;
+  std::vector< std::string > addresses;
+  std::string public_keys;
+};
+
+key_chunk generate_keys( const std::string& seed, uint64_t begin, uint64_t end, bool keystore, bool echo )
+{
+  key_chunk chunk;
+
+  if( keystore )
+  {
+    chunk.keys.reserve( end - begin );
+    chunk.addresses.reserve( end - begin );
+  }
+  else
+    chunk.wifs.reserve( ( end - begin ) * 52 );
+
+  if( echo )
+    chunk.public_keys.reserve( ( end - begin ) * 56 );
+
+  for( uint64_t i = begin; i < end; i++ )
+  {
+    auto private_key = koinos::tools::derive_dev_key( seed, i );
+
+    // Deriving the public key dominates the cost of a key, it is done at most once and only when needed
+    std::string address;
+    if( keystore || echo )
+      address = private_key.get_public_key().to_address_bytes();
+
+    if( keystore )
+    {
+      chunk.keys.push_back( private_key );
+      chunk.addresses.push_back( address );
+    }
+    else
+    {
+      chunk.wifs += private_key.to_wif();
+      chunk.wifs += '\n';
+    }
+
+    if( echo )
+    {
+      chunk.public_keys += "Generated public key: ";
+      chunk.public_keys += koinos::util::to_base58( address );
+      chunk.public_keys += '\n';
+    }
+  }
+
+  return chunk;
+}
+
 int main( int argc, char** argv )
 {
   try
@@ -39,8 +117,19 @@ int main( int argc, char** argv )
                                        "number of keys to generate" )(
       OUTPUT_FILE_OPTION "," OUTPUT_FILE_FLAG,
       boost::program_options::value< std::string >()->default_value( OUTPUT_FILE_DEFAULT ),
-      "file to output keys to" );
-    ;
+      "file to output keys to" )( THREADS_OPTION "," THREADS_FLAG,
+                                  boost::program_options::value< std::size_t >()->default_value( 0 ),
+                                  "number of threads to generate keys with, 0 uses all cores" )(
+      QUIET_OPTION "," QUIET_FLAG,
+      "do not print each generated public key" )(
+      FORMAT_OPTION "," FORMAT_FLAG,
+      boost::program_options::value< std::string >()->default_value( FORMAT_WIF ),
+      "output format, one of 'wif' or 'keystore'" )(
+      LOOKUP_OPTION "," LOOKUP_FLAG,
+      boost::program_options::value< std::string >(),
+      "print the private key for a base58 address from the keystore output file" );
+
+    koinos::tools::add_stats_options( options );
 
     // Parse command-line options
     boost::program_options::variables_map args;
@@ -53,6 +142,8 @@ int main( int argc, char** argv )
       return EXIT_SUCCESS;
     }
 
+    auto stats = koinos::tools::make_stats_reporter( args, "koinos_get_dev_key" );
+
     auto seed = args[ SEED_OPTION ].as< std::string >();
     if( !seed.size() )
     {
@@ -65,7 +156,33 @@ int main( int argc, char** argv )
       output_file = std::filesystem::current_path() / output_file;
     }
 
-    auto num_keys = args[ NUM_KEYS_OPTION ].as< uint64_t >();
+    if( args.count( LOOKUP_OPTION ) )
+    {
+      koinos::tools::keystore keys( output_file );
+      auto address = koinos::util::from_base58< std::string >( args[ LOOKUP_OPTION ].as< std::string >() );
+
+      if( auto index = keys.find( address ) )
+      {
+        std::cout << "Index: " << *index << "\n";
+        std::cout << "Private key: " << keys.at( *index ).to_wif() << std::endl;
+        return EXIT_SUCCESS;
+      }
+
+      std::cout << "Address not found in " << output_file.string() << std::endl;
+      return EXIT_FAILURE;
+    }
+
+    auto format = args[ FORMAT_OPTION ].as< std::string >();
+    if( format != FORMAT_WIF && format != FORMAT_KEYSTORE )
+      throw std::runtime_error( "unknown output format '" + format + "'" );
+
+    bool keystore    = format == FORMAT_KEYSTORE;
+    auto num_keys    = args[ NUM_KEYS_OPTION ].as< uint64_t >();
+    auto num_threads = args[ THREADS_OPTION ].as< std::size_t >();
+    bool echo        = !args.count( QUIET_OPTION );
+
+    if( !num_threads )
+      num_threads = koinos::tools::ordered_executor< uint64_t, key_chunk >::default_concurrency();
 
     std::cout << "koinos_get_dev_key generates development keys.\n\n";
     std::cout << "WARNING!!!\n\n";
@@ -75,18 +192,60 @@ int main( int argc, char** argv )
       << "For these reasons, keys generated with koinos_get_dev_key should ONLY be used for development purposes.\n\n";
 
     std::ofstream outstream;
-    outstream.open( output_file.string() );
+    std::optional< koinos::tools::keystore_writer > keystore_writer;
+
+    if( keystore )
+      keystore_writer.emplace( output_file );
+    else
+      outstream.open( output_file.string() );
+
+    auto start = std::chrono::steady_clock::now();
+
+    // Chunks are generated concurrently and written in index order, so output matches a serial run
+    koinos::tools::ordered_executor< uint64_t, key_chunk > executor(
+      num_threads,
+      num_threads * 4,
+      [ & ]( uint64_t& begin, std::size_t )
+      {
+        return generate_keys( seed, begin, std::min( begin + KEYS_PER_CHUNK, num_keys ), keystore, echo );
+      },
+      [ & ]( key_chunk& chunk )
+      {
+        if( keystore )
+        {
+          for( std::size_t i = 0; i < chunk.keys.size(); i++ )
+            keystore_writer->add( chunk.keys[ i ], std::move( chunk.addresses[ i ] ) );
+        }
+        else
+        {
+          outstream << chunk.wifs;
+        }
+
+        std::cout << chunk.public_keys;
+      } );
 
-    for( uint64_t i = 0; i < num_keys; i++ )
+    for( uint64_t begin = 0; begin < num_keys; begin += KEYS_PER_CHUNK )
+      executor.push( begin );
+
+    executor.finish();
+
+    if( keystore )
     {
-      auto secret      = koinos::crypto::hash( koinos::crypto::multicodec::sha2_256, seed, i );
-      auto private_key = koinos::crypto::private_key::regenerate( secret );
-      auto b58_pubkey  = koinos::util::to_base58( private_key.get_public_key().to_address_bytes() );
-      std::cout << "Generated public key: " << b58_pubkey << std::endl;
-      outstream << private_key.to_wif() << std::endl;
+      keystore_writer->close();
+    }
+    else
+    {
+      outstream.close();
+
+      if( !outstream )
+        throw std::runtime_error( "error writing keys to " + output_file.string() );
     }
 
-    outstream.close();
+    auto elapsed = std::chrono::duration< double >( std::chrono::steady_clock::now() - start ).count();
+    std::cout << "\nGenerated " << num_keys << " keys in " << elapsed << "s";
+    if( elapsed > 0 )
+      std::cout << " (" << uint64_t( num_keys / elapsed ) << " keys/s)";
+    std::cout << std::endl;
 
     return EXIT_SUCCESS;
   }
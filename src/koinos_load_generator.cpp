@@ -0,0 +1,642 @@
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <fstream>
+#include <future>
+#include <iostream>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include <boost/asio.hpp>
+#include <boost/program_options.hpp>
+
+#include <koinos/crypto/elliptic.hpp>
+#include <koinos/crypto/multihash.hpp>
+#include <koinos/exception.hpp>
+#include <koinos/log.hpp>
+#include <koinos/mq/client.hpp>
+#include <koinos/util/base58.hpp>
+#include <koinos/util/base64.hpp>
+#include <koinos/util/conversion.hpp>
+#include <koinos/util/services.hpp>
+
+#include <koinos/contracts/token/token.pb.h>
+#include <koinos/protocol/protocol.pb.h>
+#include <koinos/rpc/chain/chain_rpc.pb.h>
+
+#include <koinos/tools/genesis.hpp>
+#include <koinos/tools/keystore.hpp>
+#include <koinos/tools/latency_histogram.hpp>
+#include <koinos/tools/ordered_executor.hpp>
+#include <koinos/tools/records.hpp>
+#include <koinos/tools/resources.hpp>
+#include <koinos/tools/signing.hpp>
+#include <koinos/tools/stats.hpp>
+#include <koinos/tools/transaction.hpp>
+
+// Command line option definitions
+#define HELP_OPTION "help"
+#define HELP_FLAG   "h"
+
+#define SEED_OPTION "seed"
+#define SEED_FLAG   "s"
+
+#define ACCOUNTS_OPTION "accounts"
+#define ACCOUNTS_FLAG   "a"
+
+#define COUNT_OPTION "count"
+#define COUNT_FLAG   "n"
+
+#define DURATION_OPTION "duration"
+#define DURATION_FLAG   "d"
+
+#define RATE_OPTION "rate"
+#define RATE_FLAG   "r"
+
+#define TYPE_OPTION "type"
+const std::string TYPE_TRANSFER = "transfer";
+const std::string TYPE_CALL     = "call";
+
+#define TOKEN_CONTRACT_OPTION "token-contract"
+
+#define AMOUNT_OPTION "amount"
+
+#define CONTRACT_OPTION "contract"
+
+#define ENTRY_POINT_OPTION "entry-point"
+
+#define ARGS_OPTION "args"
+
+#define CHAIN_ID_OPTION "chain-id"
+
+#define RC_LIMIT_OPTION "rc-limit"
+
+#define NONCE_FILE_OPTION "nonce-file"
+
+#define OUTPUT_OPTION "output"
+#define OUTPUT_FLAG   "o"
+
+#define AMQP_OPTION "amqp"
+
+#define MAX_IN_FLIGHT_OPTION "max-in-flight"
+
+#define THREADS_OPTION "threads"
+#define THREADS_FLAG   "t"
+
+// The KOIN token contract and its transfer entry point
+const std::string KOIN_CONTRACT_ADDRESS = "15DJN4a8SgrbGhhGksSBASiSYjGnMU8dGL";
+const uint32_t TRANSFER_ENTRY_POINT     = 0x27f576ca;
+
+// Transactions in flight per signing thread
+const std::size_t LOAD_QUEUE_DEPTH_PER_THREAD = 256;
+
+// A transaction emitted this much later than the target rate schedules it counts as late
+const std::chrono::milliseconds LATE_THRESHOLD( 1 );
+
+// How long to wait for the chain to answer a submitted transaction
+const std::chrono::milliseconds SUBMIT_TIMEOUT( 10'000 );
+
+using namespace koinos;
+
+struct account
+{
+  crypto::private_key key;
+  std::string address;
+};
+
+// Everything a transaction needs beyond its payer and nonce
+struct load_template
+{
+  std::string chain_id;
+  uint64_t rc_limit = 0; // 0 sets each transaction's rc_limit from an estimate
+  bool transfer     = true;
+  std::string contract_id;
+  uint32_t entry_point = 0;
+  std::string args;
+  uint64_t amount = 0;
+};
+
+// A transaction with its payer and nonce assigned in order by the producer, completed and signed on a worker
+struct load_job
+{
+  uint64_t index = 0;
+  protocol::transaction transaction;
+};
+
+struct load_result
+{
+  std::string record;  // Length delimited transaction for the output file
+  std::string request; // Serialized chain request submitting the transaction
+};
+
+// Scratch state reused across transactions by a single worker
+struct load_context
+{
+  std::vector< crypto::private_key > signing_keys;
+  rpc::chain::chain_request request;
+};
+
+// Derive the accounts of a seed across threads, the keys koinos_get_dev_key generates for the same seed
+std::vector< account > derive_accounts( const std::string& seed, uint64_t count, std::size_t num_threads )
+{
+  std::vector< account > accounts( count );
+  std::vector< std::thread > threads;
+  std::atomic< uint64_t > next = 0;
+
+  for( std::size_t t = 0; t < std::min< uint64_t >( num_threads, count ); t++ )
+  {
+    threads.emplace_back(
+      [ & ]()
+      {
+        for( auto i = next++; i < count; i = next++ )
+        {
+          accounts[ i ].key     = tools::derive_dev_key( seed, i );
+          accounts[ i ].address = accounts[ i ].key.get_public_key().to_address_bytes();
+        }
+      } );
+  }
+
+  for( auto& thread: threads )
+    thread.join();
+
+  return accounts;
+}
+
+// Complete, finalize and sign a job's transaction. Transaction i is paid by account i and transfers to account i + 1.
+load_result build_transaction( load_job& job,
+                               const std::vector< account >& accounts,
+                               const load_template& tmpl,
+                               const tools::rc_estimator& estimator,
+                               const tools::record_options& opts,
+                               bool write_record,
+                               bool publish,
+                               load_context& ctx )
+{
+  const auto& payer = accounts[ job.index % accounts.size() ];
+  auto& transaction = job.transaction;
+
+  auto header = transaction.mutable_header();
+  header->set_chain_id( tmpl.chain_id );
+
+  auto call = transaction.add_operations()->mutable_call_contract();
+  call->set_contract_id( tmpl.contract_id );
+
+  if( tmpl.transfer )
+  {
+    contracts::token::transfer_arguments args;
+    args.set_from( payer.address );
+    args.set_to( accounts[ ( job.index + 1 ) % accounts.size() ].address );
+    args.set_value( tmpl.amount );
+
+    call->set_entry_point( TRANSFER_ENTRY_POINT );
+    call->set_args( util::converter::as< std::string >( args ) );
+  }
+  else
+  {
+    call->set_entry_point( tmpl.entry_point );
+    call->set_args( tmpl.args );
+  }
+
+  header->set_rc_limit( tmpl.rc_limit ? tmpl.rc_limit : estimator.estimate( transaction, 1 ).rc_limit );
+
+  tools::finalize_transaction( transaction );
+
+  ctx.signing_keys.assign( 1, payer.key );
+  tools::sign_transaction( transaction, ctx.signing_keys );
+
+  load_result result;
+
+  if( write_record )
+    tools::serialize_record( transaction, opts, result.record );
+
+  if( publish )
+  {
+    tools::wrap_transaction( transaction, ctx.request );
+    result.request = ctx.request.SerializeAsString();
+  }
+
+  return result;
+}
+
+// Submits transactions to the chain over AMQP. Responses are collected in order on a thread of their own, so
+// submitting only waits on the chain once max_in_flight submissions are outstanding.
+class amqp_publisher
+{
+public:
+  amqp_publisher( const std::string& url, std::size_t max_in_flight ):
+      _client( _ioc ),
+      _work( boost::asio::make_work_guard( _ioc ) ),
+      _max_in_flight( std::max< std::size_t >( max_in_flight, 1 ) )
+  {
+    _client.connect( url );
+
+    _io_thread = std::thread(
+      [ this ]()
+      {
+        _ioc.run();
+      } );
+
+    _collector = std::thread( &amqp_publisher::collect_main, this );
+  }
+
+  ~amqp_publisher()
+  {
+    finish();
+  }
+
+  void submit( const std::string& request )
+  {
+    std::unique_lock lock( _mutex );
+    _space_cv.wait( lock,
+                    [ & ]()
+                    {
+                      return _pending.size() < _max_in_flight;
+                    } );
+
+    auto sent = std::chrono::steady_clock::now();
+    _pending.emplace_back( _client.rpc( util::service::chain, request, SUBMIT_TIMEOUT, mq::retry_policy::none ),
+                           sent );
+    _pending_cv.notify_one();
+  }
+
+  // Wait for every outstanding response and disconnect
+  void finish()
+  {
+    {
+      std::lock_guard lock( _mutex );
+      if( _done )
+        return;
+
+      _done = true;
+    }
+
+    _pending_cv.notify_all();
+    _collector.join();
+
+    _client.disconnect();
+    _work.reset();
+    _ioc.stop();
+    _io_thread.join();
+  }
+
+  void report() const
+  {
+    LOG( info ) << "Chain accepted " << _accepted << ", rejected " << _rejected << " and did not answer " << _failed
+                << " transactions, round trip p50 "
+                << std::chrono::duration_cast< std::chrono::microseconds >( _round_trip.percentile( 0.5 ) ).count()
+                << "us p99 "
+                << std::chrono::duration_cast< std::chrono::microseconds >( _round_trip.percentile( 0.99 ) ).count()
+                << "us max "
+                << std::chrono::duration_cast< std::chrono::microseconds >( _round_trip.max() ).count() << "us";
+  }
+
+private:
+  void collect_main()
+  {
+    rpc::chain::chain_response response;
+
+    for( ;; )
+    {
+      std::unique_lock lock( _mutex );
+      _pending_cv.wait( lock,
+                        [ & ]()
+                        {
+                          return !_pending.empty() || _done;
+                        } );
+
+      if( _pending.empty() )
+        return;
+
+      auto [ future, sent ] = std::move( _pending.front() );
+      _pending.pop_front();
+      lock.unlock();
+      _space_cv.notify_one();
+
+      try
+      {
+        const auto& payload = future.get();
+        _round_trip.record( std::chrono::steady_clock::now() - sent );
+
+        if( response.ParseFromString( payload ) && response.has_submit_transaction() )
+          _accepted++;
+        else
+          _rejected++;
+      }
+      catch( const std::exception& e )
+      {
+        if( !_failed++ )
+          LOG( warning ) << "Submitting transaction failed: " << e.what();
+      }
+    }
+  }
+
+  boost::asio::io_context _ioc;
+  mq::client _client;
+  boost::asio::executor_work_guard< boost::asio::io_context::executor_type > _work;
+  std::thread _io_thread;
+  std::thread _collector;
+
+  std::size_t _max_in_flight;
+  std::mutex _mutex;
+  std::condition_variable _pending_cv;
+  std::condition_variable _space_cv;
+  std::deque< std::pair< std::shared_future< std::string >, std::chrono::steady_clock::time_point > > _pending;
+  bool _done = false;
+
+  uint64_t _accepted = 0;
+  uint64_t _rejected = 0;
+  uint64_t _failed   = 0;
+  tools::latency_histogram _round_trip;
+};
+
+std::string microseconds( std::chrono::nanoseconds duration )
+{
+  return std::to_string( std::chrono::duration_cast< std::chrono::microseconds >( duration ).count() ) + "us";
+}
+
+int main( int argc, char** argv )
+{
+  try
+  {
+    // Setup command line options
+    boost::program_options::options_description options( "Options" );
+    options.add_options()( HELP_OPTION "," HELP_FLAG, "print usage message" )(
+      SEED_OPTION "," SEED_FLAG,
+      boost::program_options::value< std::string >()->default_value( "load" ),
+      "seed the accounts are derived from, as koinos_get_dev_key derives keys" )(
+      ACCOUNTS_OPTION "," ACCOUNTS_FLAG,
+      boost::program_options::value< uint64_t >()->default_value( 100 ),
+      "number of accounts paying for transactions in turn" )(
+      COUNT_OPTION "," COUNT_FLAG,
+      boost::program_options::value< uint64_t >()->default_value( 10'000 ),
+      "number of transactions to generate, 0 generates until --" DURATION_OPTION " elapses" )(
+      DURATION_OPTION "," DURATION_FLAG,
+      boost::program_options::value< double >()->default_value( 0 ),
+      "seconds to generate for, 0 generates --" COUNT_OPTION " transactions" )(
+      RATE_OPTION "," RATE_FLAG,
+      boost::program_options::value< double >()->default_value( 0 ),
+      "target transactions per second, 0 generates as fast as possible" )(
+      TYPE_OPTION,
+      boost::program_options::value< std::string >()->default_value( TYPE_TRANSFER ),
+      "transaction type, 'transfer' (token transfers between accounts) or 'call' (a fixed contract call)" )(
+      TOKEN_CONTRACT_OPTION,
+      boost::program_options::value< std::string >()->default_value( KOIN_CONTRACT_ADDRESS ),
+      "base58 address of the token contract to transfer" )(
+      AMOUNT_OPTION,
+      boost::program_options::value< uint64_t >()->default_value( 1 ),
+      "amount of each transfer" )( CONTRACT_OPTION,
+                                   boost::program_options::value< std::string >(),
+                                   "base58 address of the contract to call" )(
+      ENTRY_POINT_OPTION,
+      boost::program_options::value< uint32_t >()->default_value( 0 ),
+      "entry point to call" )( ARGS_OPTION,
+                               boost::program_options::value< std::string >()->default_value( "" ),
+                               "base64 encoded arguments of each call" )(
+      CHAIN_ID_OPTION,
+      boost::program_options::value< std::string >(),
+      "base64 encoded chain id, defaults to that of the default genesis data" )(
+      RC_LIMIT_OPTION,
+      boost::program_options::value< uint64_t >()->default_value( 0 ),
+      "rc_limit of each transaction, 0 sets it from an estimate of the transaction's cost" )(
+      NONCE_FILE_OPTION,
+      boost::program_options::value< std::string >(),
+      "file of '<address> <nonce>' lines with the current nonce of accounts that have transacted" )(
+      OUTPUT_OPTION "," OUTPUT_FLAG,
+      boost::program_options::value< std::string >(),
+      "file to write varint length delimited transactions to" )(
+      AMQP_OPTION,
+      boost::program_options::value< std::string >(),
+      "AMQP url of the broker to submit transactions to the chain through" )(
+      MAX_IN_FLIGHT_OPTION,
+      boost::program_options::value< std::size_t >()->default_value( 1'024 ),
+      "submissions awaiting a response from the chain before submitting waits" )(
+      THREADS_OPTION "," THREADS_FLAG,
+      boost::program_options::value< std::size_t >()->default_value( 0 ),
+      "number of signing threads, 0 uses all cores" );
+
+    tools::add_stats_options( options );
+
+    // Parse command-line options
+    boost::program_options::variables_map vm;
+    boost::program_options::store( boost::program_options::parse_command_line( argc, argv, options ), vm );
+
+    // Handle help message
+    if( vm.count( HELP_OPTION ) )
+    {
+      std::cout << "Koinos Load Generator" << std::endl;
+      std::cout << "Generates signed transactions from accounts derived from a seed, with sequential nonces per payer"
+                << std::endl;
+      std::cout << "Writes them to a file and/or submits them to the chain over AMQP at a target rate" << std::endl
+                << std::endl;
+      std::cout << options << std::endl;
+      return EXIT_SUCCESS;
+    }
+
+    auto stats = tools::make_stats_reporter( vm, "koinos_load_generator" );
+
+    auto num_accounts = vm[ ACCOUNTS_OPTION ].as< uint64_t >();
+    auto count        = vm[ COUNT_OPTION ].as< uint64_t >();
+    auto duration     = std::chrono::duration< double >( vm[ DURATION_OPTION ].as< double >() );
+    auto rate         = vm[ RATE_OPTION ].as< double >();
+    auto num_threads  = vm[ THREADS_OPTION ].as< std::size_t >();
+    auto type         = vm[ TYPE_OPTION ].as< std::string >();
+
+    if( !num_accounts )
+      throw std::runtime_error( "at least one account is required" );
+
+    if( !count && duration.count() <= 0 )
+      throw std::runtime_error( "one of --" COUNT_OPTION " or --" DURATION_OPTION " is required" );
+
+    if( !vm.count( OUTPUT_OPTION ) && !vm.count( AMQP_OPTION ) )
+      throw std::runtime_error( "one of --" OUTPUT_OPTION " or --" AMQP_OPTION " is required" );
+
+    if( !num_threads )
+      num_threads = tools::ordered_executor< load_job, load_result >::default_concurrency();
+
+    load_template tmpl;
+    tmpl.rc_limit = vm[ RC_LIMIT_OPTION ].as< uint64_t >();
+
+    if( type == TYPE_TRANSFER )
+    {
+      tmpl.transfer    = true;
+      tmpl.contract_id = util::from_base58< std::string >( vm[ TOKEN_CONTRACT_OPTION ].as< std::string >() );
+      tmpl.amount      = vm[ AMOUNT_OPTION ].as< uint64_t >();
+    }
+    else if( type == TYPE_CALL )
+    {
+      if( !vm.count( CONTRACT_OPTION ) )
+        throw std::runtime_error( "--" CONTRACT_OPTION " is required for call transactions" );
+
+      tmpl.transfer    = false;
+      tmpl.contract_id = util::from_base58< std::string >( vm[ CONTRACT_OPTION ].as< std::string >() );
+      tmpl.entry_point = vm[ ENTRY_POINT_OPTION ].as< uint32_t >();
+      tmpl.args        = util::from_base64< std::string >( vm[ ARGS_OPTION ].as< std::string >() );
+    }
+    else
+    {
+      throw std::runtime_error( "unknown transaction type '" + type + "'" );
+    }
+
+    if( vm.count( CHAIN_ID_OPTION ) )
+      tmpl.chain_id = util::from_base64< std::string >( vm[ CHAIN_ID_OPTION ].as< std::string >() );
+    else
+      tmpl.chain_id = util::converter::as< std::string >(
+        crypto::hash( crypto::multicodec::sha2_256, tools::default_genesis_data() ) );
+
+    auto derive_start = std::chrono::steady_clock::now();
+    auto accounts     = derive_accounts( vm[ SEED_OPTION ].as< std::string >(), num_accounts, num_threads );
+
+    LOG( info ) << "Derived " << num_accounts << " accounts in "
+                << std::chrono::duration< double >( std::chrono::steady_clock::now() - derive_start ).count() << "s";
+
+    // Accounts start from nonce 0 unless the nonce file says they have transacted
+    tools::nonce_tracker nonces;
+    for( const auto& acct: accounts )
+      nonces.set_account_nonce( acct.address, 0 );
+
+    if( vm.count( NONCE_FILE_OPTION ) )
+      nonces.load( vm[ NONCE_FILE_OPTION ].as< std::string >() );
+
+    tools::rc_estimator estimator;
+    auto opts = tools::make_record_options( tools::record_format::binary, tools::record_format::binary );
+
+    std::ofstream output;
+    if( vm.count( OUTPUT_OPTION ) )
+    {
+      auto filename = vm[ OUTPUT_OPTION ].as< std::string >();
+      output.open( filename, std::ios::binary );
+      if( !output )
+        throw std::runtime_error( "unable to open " + filename );
+    }
+
+    std::unique_ptr< amqp_publisher > publisher;
+    if( vm.count( AMQP_OPTION ) )
+      publisher = std::make_unique< amqp_publisher >( vm[ AMQP_OPTION ].as< std::string >(),
+                                                      vm[ MAX_IN_FLIGHT_OPTION ].as< std::size_t >() );
+
+    bool write_record = output.is_open();
+    bool publish      = bool( publisher );
+
+    std::vector< load_context > contexts( num_threads );
+    tools::latency_histogram generation_latency;
+
+    uint64_t emitted = 0;
+    uint64_t late    = 0;
+    std::chrono::nanoseconds max_lag( 0 );
+
+    auto start          = std::chrono::steady_clock::now();
+    auto schedule_start = start;
+
+    tools::ordered_executor< load_job, load_result > executor(
+      num_threads,
+      num_threads * LOAD_QUEUE_DEPTH_PER_THREAD,
+      [ & ]( load_job& job, std::size_t worker )
+      {
+        auto& ctx   = contexts[ worker ];
+        auto begin  = std::chrono::steady_clock::now();
+        auto result = build_transaction( job, accounts, tmpl, estimator, opts, write_record, publish, ctx );
+        generation_latency.record( std::chrono::steady_clock::now() - begin );
+        return result;
+      },
+      [ & ]( load_result& result )
+      {
+        // Pace emission to the target rate, noting transactions the generator could not produce in time
+        if( rate > 0 )
+        {
+          auto now = std::chrono::steady_clock::now();
+          if( !emitted )
+            schedule_start = now;
+
+          auto scheduled = schedule_start
+                           + std::chrono::duration_cast< std::chrono::steady_clock::duration >(
+                             std::chrono::duration< double >( emitted / rate ) );
+
+          if( now < scheduled )
+          {
+            std::this_thread::sleep_until( scheduled );
+          }
+          else if( now - scheduled > LATE_THRESHOLD )
+          {
+            late++;
+            max_lag = std::max< std::chrono::nanoseconds >( max_lag, now - scheduled );
+          }
+        }
+
+        if( write_record )
+        {
+          tools::stage_timer timer( tools::stage::write );
+          tools::add_stage_bytes( tools::stage::write, result.record.size() );
+          output.write( result.record.data(), result.record.size() );
+        }
+
+        if( publish )
+          publisher->submit( result.request );
+
+        emitted++;
+      } );
+
+    for( uint64_t i = 0; !count || i < count; i++ )
+    {
+      if( duration.count() > 0 && std::chrono::steady_clock::now() - start >= duration )
+        break;
+
+      load_job job;
+      job.index = i;
+      job.transaction.mutable_header()->set_payer( accounts[ i % num_accounts ].address );
+      nonces.assign( job.transaction );
+
+      executor.push( std::move( job ) );
+    }
+
+    executor.finish();
+
+    auto elapsed = std::chrono::duration< double >( std::chrono::steady_clock::now() - start ).count();
+
+    if( write_record )
+    {
+      output.close();
+      if( !output )
+        throw std::runtime_error( "error writing transactions to " + vm[ OUTPUT_OPTION ].as< std::string >() );
+    }
+
+    LOG( info ) << "Generated " << emitted << " transactions in " << elapsed << "s ("
+                << ( elapsed > 0 ? uint64_t( emitted / elapsed ) : 0 ) << " tps) on " << num_threads << " threads";
+    LOG( info ) << "Generation latency p50 " << microseconds( generation_latency.percentile( 0.5 ) ) << " p99 "
+                << microseconds( generation_latency.percentile( 0.99 ) ) << " max "
+                << microseconds( generation_latency.max() );
+
+    if( rate > 0 )
+    {
+      if( late )
+        LOG( warning ) << late << " of " << emitted << " transactions were emitted behind the target rate of " << rate
+                       << " tps, by up to " << microseconds( max_lag ) << ", the generator is a bottleneck";
+      else
+        LOG( info ) << "Kept up with the target rate of " << rate << " tps";
+    }
+
+    if( publisher )
+    {
+      publisher->finish();
+      publisher->report();
+    }
+
+    return EXIT_SUCCESS;
+  }
+  catch( const boost::exception& e )
+  {
+    LOG( fatal ) << boost::diagnostic_information( e ) << std::endl;
+  }
+  catch( const std::exception& e )
+  {
+    LOG( fatal ) << e.what() << std::endl;
+  }
+  catch( ... )
+  {
+    LOG( fatal ) << "unknown exception" << std::endl;
+  }
+
+  return EXIT_FAILURE;
+}
@@ -0,0 +1,266 @@
+#include <fstream>
+#include <iostream>
+#include <string>
+
+#include <boost/program_options.hpp>
+
+#include <google/protobuf/util/json_util.h>
+
+#include <nlohmann/json.hpp>
+
+#include <koinos/exception.hpp>
+#include <koinos/log.hpp>
+#include <koinos/util/base58.hpp>
+#include <koinos/util/conversion.hpp>
+#include <koinos/util/hex.hpp>
+
+#include <koinos/contracts/governance/governance.pb.h>
+
+#include <koinos/tools/merkle_tree.hpp>
+#include <koinos/tools/proposal.hpp>
+#include <koinos/tools/records.hpp>
+#include <koinos/tools/stats.hpp>
+
+// Command line option definitions
+#define HELP_OPTION "help"
+#define HELP_FLAG   "h"
+
+#define INPUT_OPTION "input"
+
+#define OUTPUT_FORMAT_OPTION "output-format"
+#define OUTPUT_FORMAT_FLAG   "o"
+
+#define PROOFS_OPTION "proofs"
+#define PROOFS_FLAG   "p"
+
+#define VERIFY_OPTION "verify"
+#define VERIFY_FLAG   "v"
+
+#define ROOT_OPTION "root"
+#define ROOT_FLAG   "r"
+
+using namespace koinos;
+
+// The operations committed to by the proposal id, or by the transaction's operation merkle root when there is no
+// proposal
+google::protobuf::RepeatedPtrField< protocol::operation > committed_operations( const tools::proposal& proposal )
+{
+  if( proposal.id.empty() )
+    return proposal.transaction.operations();
+
+  return util::converter::to< contracts::governance::submit_proposal_arguments >(
+           proposal.transaction.operations( 0 ).call_contract().args() )
+    .operations();
+}
+
+std::string encode_hash( const crypto::multihash& hash )
+{
+  return util::to_hex( util::converter::as< std::string >( hash ) );
+}
+
+crypto::multihash decode_hash( const nlohmann::json& json )
+{
+  return util::converter::to< crypto::multihash >( util::from_hex< std::string >( json.get< std::string >() ) );
+}
+
+// Write one inclusion proof per committed operation, each can be checked on its own with --verify
+void write_proofs( const tools::proposal& proposal, const std::string& filename )
+{
+  std::ofstream stream( filename );
+  if( !stream )
+    throw std::runtime_error( "unable to open " + filename );
+
+  auto operations = committed_operations( proposal );
+  auto tree       = tools::merkle_tree::from_messages( crypto::multicodec::sha2_256, operations );
+
+  google::protobuf::util::JsonPrintOptions print_options;
+  print_options.preserve_proto_field_names = true;
+
+  for( int i = 0; i < operations.size(); i++ )
+  {
+    auto proof = tree.proof( i );
+
+    std::string operation;
+    google::protobuf::util::MessageToJsonString( operations.Get( i ), &operation, print_options );
+
+    nlohmann::json line = {
+      {    "index",                      proof.index },
+      {   "leaves",                     proof.leaves },
+      {"operation", nlohmann::json::parse( operation ) },
+      {     "leaf",         encode_hash( tree.leaf( i ) ) },
+      { "siblings",          nlohmann::json::array() },
+      {     "root",           encode_hash( tree.root() ) }
+    };
+
+    for( const auto& sibling: proof.siblings )
+      line[ "siblings" ].push_back( encode_hash( sibling ) );
+
+    stream << line.dump() << "\n";
+  }
+
+  if( !stream )
+    throw std::runtime_error( "error writing " + filename );
+}
+
+// Check each proof in a file against the expected root, recomputing the leaf from the operation. The root stored
+// with a proof is only compared, never trusted, so a proof for another set of operations is rejected. Returns the
+// number of invalid proofs.
+uint64_t verify_proofs( const std::string& filename, const crypto::multihash& root )
+{
+  std::ifstream stream( filename );
+  if( !stream )
+    throw std::runtime_error( "unable to open " + filename );
+
+  uint64_t invalid = 0;
+  std::string line;
+
+  while( std::getline( stream, line ) )
+  {
+    if( line.empty() )
+      continue;
+
+    auto json = nlohmann::json::parse( line );
+
+    protocol::operation operation;
+    auto status = google::protobuf::util::JsonStringToMessage( json[ "operation" ].dump(), &operation );
+    if( !status.ok() )
+      throw std::runtime_error( "unable to parse operation: " + status.ToString() );
+
+    tools::merkle_proof proof;
+    proof.index  = json[ "index" ].get< uint64_t >();
+    proof.leaves = json[ "leaves" ].get< uint64_t >();
+    for( const auto& sibling: json[ "siblings" ] )
+      proof.siblings.push_back( decode_hash( sibling ) );
+
+    bool valid = decode_hash( json[ "root" ] ) == root;
+
+    if( !valid )
+      LOG( error ) << "Proof " << proof.index << " is for root " << json[ "root" ].get< std::string >();
+    else
+      valid = tools::verify_merkle_proof( crypto::multicodec::sha2_256,
+                                          crypto::hash( crypto::multicodec::sha2_256, operation ),
+                                          proof,
+                                          root );
+
+    if( !valid )
+      invalid++;
+
+    std::cout << nlohmann::json( {
+                   { "index", proof.index },
+                   {  "root", json[ "root" ] },
+                   { "valid",       valid }
+    } ).dump()
+              << "\n";
+  }
+
+  std::cout.flush();
+  return invalid;
+}
+
+int main( int argc, char** argv )
+{
+  try
+  {
+    // Setup command line options
+    boost::program_options::options_description options( "Options" );
+    options.add_options()( HELP_OPTION "," HELP_FLAG, "print usage message" )(
+      OUTPUT_FORMAT_OPTION "," OUTPUT_FORMAT_FLAG,
+      boost::program_options::value< std::string >()->default_value( "json" ),
+      "output format: json, compact (single line json), binary or base64" )(
+      PROOFS_OPTION "," PROOFS_FLAG,
+      boost::program_options::value< std::string >(),
+      "write a merkle inclusion proof of each proposed operation to this file" )(
+      VERIFY_OPTION "," VERIFY_FLAG,
+      boost::program_options::value< std::string >(),
+      "verify the inclusion proofs in a file written by --" PROOFS_OPTION " instead of building a proposal" )(
+      ROOT_OPTION "," ROOT_FLAG,
+      boost::program_options::value< std::string >(),
+      "hex operation merkle root the proofs must be for, the proposal id when submitted to governance, required with "
+      "--" VERIFY_OPTION );
+
+    tools::add_stats_options( options );
+
+    boost::program_options::options_description hidden( "Hidden options" );
+    hidden.add_options()( INPUT_OPTION, boost::program_options::value< std::string >() );
+
+    boost::program_options::options_description all_options;
+    all_options.add( options ).add( hidden );
+
+    boost::program_options::positional_options_description positional;
+    positional.add( INPUT_OPTION, 1 );
+
+    // Parse command-line options
+    boost::program_options::variables_map vm;
+    boost::program_options::store(
+      boost::program_options::command_line_parser( argc, argv ).options( all_options ).positional( positional ).run(),
+      vm );
+
+    // Handle help message
+    if( vm.count( HELP_OPTION ) || !( vm.count( INPUT_OPTION ) || vm.count( VERIFY_OPTION ) ) )
+    {
+      std::cout << "Koinos Proposal Builder" << std::endl;
+      std::cout << "Usage: koinos_proposal_builder [options] <proposal>" << std::endl;
+      std::cout << "Builds an unsigned transaction from a file of operations, wrapped in a governance proposal"
+                << std::endl;
+      std::cout << "Returns the transaction, ready for koinos_transaction_signer, via STDOUT" << std::endl
+                << std::endl;
+      std::cout << options << std::endl;
+      return vm.count( HELP_OPTION ) ? EXIT_SUCCESS : EXIT_FAILURE;
+    }
+
+    koinos::initialize_logging( "koinos_proposal_builder", {}, "info" );
+
+    if( vm.count( VERIFY_OPTION ) )
+    {
+      if( !vm.count( ROOT_OPTION ) )
+        throw std::invalid_argument( "--" VERIFY_OPTION " requires the expected --" ROOT_OPTION );
+
+      auto root    = decode_hash( vm[ ROOT_OPTION ].as< std::string >() );
+      auto invalid = verify_proofs( vm[ VERIFY_OPTION ].as< std::string >(), root );
+      if( invalid )
+      {
+        LOG( error ) << invalid << " proofs are invalid";
+        return EXIT_FAILURE;
+      }
+
+      return EXIT_SUCCESS;
+    }
+
+    auto stats = tools::make_stats_reporter( vm, "koinos_proposal_builder" );
+
+    auto output_format = tools::parse_record_format( vm[ OUTPUT_FORMAT_OPTION ].as< std::string >() );
+    auto opts          = tools::make_record_options( output_format, output_format );
+
+    auto proposal = tools::load_proposal_spec( vm[ INPUT_OPTION ].as< std::string >() );
+
+    if( !proposal.id.empty() )
+      LOG( info ) << "Proposal ID: " << util::to_hex( proposal.id );
+
+    LOG( info ) << "Transaction ID: " << util::to_hex( proposal.transaction.id() );
+    LOG( info ) << "Payer: " << util::to_base58( proposal.transaction.header().payer() );
+
+    if( vm.count( PROOFS_OPTION ) )
+      write_proofs( proposal, vm[ PROOFS_OPTION ].as< std::string >() );
+
+    std::string output;
+    tools::serialize_record( proposal.transaction, opts, output );
+    std::cout.write( output.data(), output.size() );
+    std::cout.flush();
+
+    return EXIT_SUCCESS;
+  }
+  catch( const boost::exception& e )
+  {
+    LOG( fatal ) << boost::diagnostic_information( e ) << std::endl;
+  }
+  catch( const std::exception& e )
+  {
+    LOG( fatal ) << e.what() << std::endl;
+  }
+  catch( ... )
+  {
+    LOG( fatal ) << "unknown exception" << std::endl;
+  }
+
+  return EXIT_FAILURE;
+}
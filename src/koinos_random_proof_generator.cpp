@@ -1,4 +1,7 @@
-#include <fstream>
+#include <atomic>
+#include <chrono>
+#include <cstring>
+#include <functional>
 #include <iostream>
 
 #include <boost/program_options.hpp>
@@ -9,6 +12,14 @@
 #include <koinos/util/base64.hpp>
 #include <koinos/util/conversion.hpp>
 
+#include <koinos/tools/ordered_executor.hpp>
+#include <koinos/tools/records.hpp>
+#include <koinos/tools/signing.hpp>
+#include <koinos/tools/stats.hpp>
+
+#include <google/protobuf/struct.pb.h>
+#include <google/protobuf/util/json_util.h>
+
 // Command line option definitions
 #define HELP_OPTION "help"
 #define HELP_FLAG   "h"
@@ -19,21 +30,167 @@
 #define INPUT_OPTION "input"
 #define INPUT_FLAG   "i"
 
+#define STREAM_OPTION "stream"
+#define STREAM_FLAG   "s"
+
+#define VERIFY_OPTION "verify"
+#define VERIFY_FLAG   "v"
+
+#define PUBLIC_KEY_OPTION "public-key"
+
+#define BINARY_OPTION "binary"
+#define BINARY_FLAG   "b"
+
+#define THREADS_OPTION "threads"
+#define THREADS_FLAG   "t"
+
+// Maximum number of inputs in flight per worker thread
+const std::size_t PROOF_QUEUE_DEPTH_PER_THREAD = 64;
+
 using namespace koinos;
 
-// Read a base58 WIF private key from the given file
-crypto::private_key read_keyfile( std::string key_filename )
+struct proof_result
+{
+  std::string output;
+  bool success = true;
+};
+
+std::string json_string( const std::string& str )
+{
+  google::protobuf::Value value;
+  value.set_string_value( str );
+
+  std::string json;
+  google::protobuf::util::MessageToJsonString( value, &json );
+  return json;
+}
+
+// Generate a proof for an input record, written as a JSON line that --verify accepts
+proof_result generate_proof( const crypto::private_key& private_key, const std::string& record, bool base64 )
+{
+  proof_result result;
+
+  try
+  {
+    auto input = base64 ? util::from_base64< std::string >( record ) : record;
+    auto [ proof, proof_hash ] = [ & ]()
+    {
+      tools::stage_timer timer( tools::stage::sign );
+      return private_key.generate_random_proof( input );
+    }();
+
+    result.output = "{ \"input\": \"" + util::to_base64< std::string >( input ) + "\", \"proof\": \""
+                    + util::to_base64< std::string >( proof ) + "\", \"proof_hash\": \""
+                    + util::to_base64< std::string >( util::converter::as< std::string >( proof_hash ) ) + "\" }\n";
+  }
+  catch( const std::exception& e )
+  {
+    result.output  = "{ \"error\": " + json_string( e.what() ) + " }\n";
+    result.success = false;
+  }
+
+  return result;
+}
+
+// Verify a JSON line with base64 encoded input, proof and proof_hash fields
+proof_result verify_proof( const crypto::public_key& public_key, const std::string& record )
+{
+  proof_result result;
+
+  try
+  {
+    google::protobuf::Struct fields;
+    if( !google::protobuf::util::JsonStringToMessage( record, &fields ).ok() )
+      throw std::runtime_error( "unable to parse proof record" );
+
+    auto field = [ & ]( const std::string& name )
+    {
+      auto itr = fields.fields().find( name );
+      if( itr == fields.fields().end() )
+        throw std::runtime_error( "proof record is missing '" + name + "'" );
+
+      return util::from_base64< std::string >( itr->second.string_value() );
+    };
+
+    auto input = field( "input" );
+    auto proof = field( "proof" );
+
+    crypto::multihash proof_hash;
+
+    {
+      tools::stage_timer timer( tools::stage::verify );
+      proof_hash = public_key.verify_random_proof( input, proof );
+    }
+
+    result.success = util::converter::as< std::string >( proof_hash ) == field( "proof_hash" );
+    result.output  = result.success ? "{ \"valid\": true }\n" : "{ \"valid\": false }\n";
+  }
+  catch( const std::exception& e )
+  {
+    result.output  = "{ \"valid\": false, \"error\": " + json_string( e.what() ) + " }\n";
+    result.success = false;
+  }
+
+  return result;
+}
+
+// Process records from STDIN across a pool of threads, writing one JSON line per record to STDOUT in input order
+uint64_t process_stream( tools::record_format format,
+                         std::size_t num_threads,
+                         std::function< proof_result( const std::string& ) > process,
+                         const std::string& name )
 {
-  // Read base58 wif string from given file
-  std::string key_string;
-  std::ifstream instream;
-  instream.open( key_filename );
-  std::getline( instream, key_string );
-  instream.close();
-
-  // Create and return the key from the wif
-  auto key = crypto::private_key::from_wif( key_string );
-  return key;
+  // Results are written from the workers while this thread reads, so reading STDIN must not flush STDOUT
+  std::ios::sync_with_stdio( false );
+  std::cin.tie( nullptr );
+
+  tools::record_reader reader( format );
+  tools::output_flusher flusher;
+  std::string record;
+  uint64_t records               = 0;
+  std::atomic< uint64_t > errors = 0;
+
+  auto start = std::chrono::steady_clock::now();
+
+  tools::ordered_executor< std::string, proof_result > executor(
+    num_threads,
+    num_threads * PROOF_QUEUE_DEPTH_PER_THREAD,
+    [ & ]( std::string& input, std::size_t )
+    {
+      auto result = process( input );
+      if( !result.success )
+        errors++;
+      return result;
+    },
+    [ & ]( proof_result& result )
+    {
+      tools::stage_timer timer( tools::stage::write );
+      tools::add_stage_bytes( tools::stage::write, result.output.size() );
+      std::cout.write( result.output.data(), result.output.size() );
+
+      if( flusher.record_written() )
+        std::cout.flush();
+    } );
+
+  while( reader.next( record ) )
+  {
+    records++;
+    flusher.record_read( reader.caught_up() );
+    executor.push( std::move( record ) );
+  }
+
+  executor.finish();
+  std::cout.flush();
+
+  auto elapsed = std::chrono::duration< double >( std::chrono::steady_clock::now() - start ).count();
+  LOG( info ) << "Processed " << records << " " << name << " in " << elapsed << "s ("
+              << ( elapsed > 0 ? uint64_t( records / elapsed ) : 0 ) << " " << name << "/s) on " << num_threads
+              << " threads";
+
+  if( errors )
+    LOG( warning ) << errors << " of " << records << " " << name << " failed";
+
+  return errors;
 }
 
 int main( int argc, char** argv )
@@ -47,7 +204,21 @@ int main( int argc, char** argv )
       boost::program_options::value< std::string >()->default_value( "private.key" ),
       "private key file" )( INPUT_OPTION "," INPUT_FLAG,
                             boost::program_options::value< std::string >()->default_value( "" ),
-                            "input to use to generate the random proof (base64 encoded)" );
+                            "input to use to generate the random proof (base64 encoded)" )(
+      STREAM_OPTION "," STREAM_FLAG,
+      "generate a proof for each base64 encoded input line from STDIN" )(
+      VERIFY_OPTION "," VERIFY_FLAG,
+      "verify each proof record line from STDIN, as written by --stream" )(
+      PUBLIC_KEY_OPTION,
+      boost::program_options::value< std::string >(),
+      "public key to verify proofs with (base64 encoded), defaults to that of the private key" )(
+      BINARY_OPTION "," BINARY_FLAG,
+      "read --stream inputs as varint length delimited raw bytes instead of base64 lines" )(
+      THREADS_OPTION "," THREADS_FLAG,
+      boost::program_options::value< std::size_t >()->default_value( 1 ),
+      "number of threads to use in --stream and --verify modes, 0 uses all cores" );
+
+    tools::add_stats_options( options );
 
     // Parse command-line options
     boost::program_options::variables_map vm;
@@ -58,17 +229,73 @@ int main( int argc, char** argv )
     {
       std::cout << "Koinos Random Proof Generator" << std::endl;
       std::cout << "Accepts an input to use to generate the random proof (base64 encoded)" << std::endl;
-      std::cout << "Returns the random proof and its hash (base64 encoded and in a JSON format) via STDOUT" << std::endl
+      std::cout << "Returns the random proof and its hash (base64 encoded and in a JSON format) via STDOUT"
                 << std::endl;
+      std::cout << "With --stream, generates a proof for each input read from STDIN" << std::endl;
+      std::cout << "With --verify, checks each proof record read from STDIN" << std::endl << std::endl;
       std::cout << options << std::endl;
       return EXIT_SUCCESS;
     }
 
+    auto stats = tools::make_stats_reporter( vm, "koinos_random_proof_generator" );
+
     // Read options into variables
     std::string key_filename = vm[ PRIVATE_KEY_OPTION ].as< std::string >();
 
+    auto num_threads = vm[ THREADS_OPTION ].as< std::size_t >();
+    if( !num_threads )
+      num_threads = tools::ordered_executor< std::string, proof_result >::default_concurrency();
+
+    if( vm.count( VERIFY_OPTION ) )
+    {
+      crypto::public_key public_key;
+
+      if( vm.count( PUBLIC_KEY_OPTION ) )
+      {
+        auto key_bytes = util::from_base64< std::string >( vm[ PUBLIC_KEY_OPTION ].as< std::string >() );
+
+        crypto::compressed_public_key compressed_key;
+        if( key_bytes.size() != compressed_key.size() )
+          throw std::runtime_error( "public key must be " + std::to_string( compressed_key.size() ) + " bytes" );
+
+        std::memcpy( compressed_key.data(), key_bytes.data(), key_bytes.size() );
+        public_key = crypto::public_key::deserialize( compressed_key );
+      }
+      else
+      {
+        public_key = tools::read_keyfile( key_filename ).get_public_key();
+      }
+
+      auto errors = process_stream(
+        tools::record_format::json,
+        num_threads,
+        [ & ]( const std::string& record )
+        {
+          return verify_proof( public_key, record );
+        },
+        "proof verifications" );
+
+      return errors ? EXIT_FAILURE : EXIT_SUCCESS;
+    }
+
     // Read the keyfile
-    auto private_key = read_keyfile( key_filename );
+    auto private_key = tools::read_keyfile( key_filename );
+
+    if( vm.count( STREAM_OPTION ) )
+    {
+      bool binary = vm.count( BINARY_OPTION );
+
+      auto errors = process_stream(
+        binary ? tools::record_format::binary : tools::record_format::json,
+        num_threads,
+        [ & ]( const std::string& record )
+        {
+          return generate_proof( private_key, record, !binary );
+        },
+        "proofs" );
+
+      return errors ? EXIT_FAILURE : EXIT_SUCCESS;
+    }
 
     std::string input = vm[ INPUT_OPTION ].as< std::string >();
 
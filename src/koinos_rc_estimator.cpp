@@ -0,0 +1,281 @@
+#include <atomic>
+#include <chrono>
+#include <fstream>
+#include <iostream>
+#include <vector>
+
+#include <boost/program_options.hpp>
+
+#include <google/protobuf/struct.pb.h>
+#include <google/protobuf/util/json_util.h>
+
+#include <koinos/exception.hpp>
+#include <koinos/log.hpp>
+
+#include <koinos/tools/genesis.hpp>
+#include <koinos/tools/ordered_executor.hpp>
+#include <koinos/tools/records.hpp>
+#include <koinos/tools/resources.hpp>
+#include <koinos/tools/stats.hpp>
+
+// Command line option definitions
+#define HELP_OPTION "help"
+#define HELP_FLAG   "h"
+
+#define GENESIS_OPTION "genesis"
+#define GENESIS_FLAG   "g"
+
+#define GENESIS_FORMAT_OPTION "genesis-format"
+
+#define INPUT_FORMAT_OPTION "input-format"
+#define INPUT_FORMAT_FLAG   "i"
+
+#define OUTPUT_FORMAT_OPTION "output-format"
+#define OUTPUT_FORMAT_FLAG   "o"
+
+#define SET_RC_LIMIT_OPTION "set-rc-limit"
+#define SET_RC_LIMIT_FLAG   "r"
+
+#define MARGIN_OPTION "margin"
+#define MARGIN_FLAG   "m"
+
+#define CALL_COMPUTE_OPTION "call-compute"
+
+#define SIGNATURES_OPTION "signatures"
+#define SIGNATURES_FLAG   "s"
+
+#define THREADS_OPTION "threads"
+#define THREADS_FLAG   "t"
+
+// Maximum number of records in flight per worker thread
+const std::size_t ESTIMATE_QUEUE_DEPTH_PER_THREAD = 256;
+
+using namespace koinos;
+
+struct estimate_result
+{
+  std::string output;
+  bool success = true;
+};
+
+std::string json_string( const std::string& str )
+{
+  google::protobuf::Value value;
+  value.set_string_value( str );
+
+  std::string json;
+  google::protobuf::util::MessageToJsonString( value, &json );
+  return json;
+}
+
+std::string to_json( const tools::resource_estimate& estimate )
+{
+  return "{ \"disk_storage\": " + std::to_string( estimate.usage.disk_storage )
+         + ", \"network_bandwidth\": " + std::to_string( estimate.usage.network_bandwidth )
+         + ", \"compute_bandwidth\": " + std::to_string( estimate.usage.compute_bandwidth )
+         + ", \"rc\": " + std::to_string( estimate.rc ) + ", \"rc_limit\": " + std::to_string( estimate.rc_limit )
+         + ", \"exceeds_limits\": " + ( estimate.exceeds_limits ? "true" : "false" ) + " }\n";
+}
+
+// Estimate one record, writing either the estimate as a JSON line or the transaction with its rc_limit set
+estimate_result estimate_record( const tools::rc_estimator& estimator,
+                                 const std::string& record,
+                                 const tools::record_options& opts,
+                                 std::size_t signatures,
+                                 bool set_rc_limit,
+                                 protocol::transaction& transaction )
+{
+  estimate_result result;
+
+  try
+  {
+    transaction.Clear();
+    tools::parse_record( record, opts, transaction );
+
+    auto existing   = std::size_t( transaction.signatures_size() );
+    auto additional = signatures > existing ? signatures - existing : 0;
+    auto estimate   = estimator.estimate( transaction, additional );
+
+    if( estimate.exceeds_limits )
+      LOG( warning ) << "Transaction needs more resources than a block allows";
+
+    if( !set_rc_limit )
+    {
+      result.output = to_json( estimate );
+      return result;
+    }
+
+    if( transaction.header().rc_limit() != estimate.rc_limit )
+    {
+      // Signatures over the old header no longer verify, the transaction must be signed after its rc_limit is set
+      transaction.mutable_header()->set_rc_limit( estimate.rc_limit );
+      transaction.clear_id();
+      transaction.clear_signatures();
+    }
+
+    tools::serialize_record( transaction, opts, result.output );
+  }
+  catch( const std::exception& e )
+  {
+    result.output  = "{ \"error\": " + json_string( e.what() ) + " }\n";
+    result.success = false;
+  }
+
+  return result;
+}
+
+int main( int argc, char** argv )
+{
+  try
+  {
+    // Setup command line options
+    boost::program_options::options_description options( "Options" );
+    options.add_options()( HELP_OPTION "," HELP_FLAG, "print usage message" )(
+      GENESIS_OPTION "," GENESIS_FLAG,
+      boost::program_options::value< std::string >(),
+      "genesis file with the resource limits and compute registry (defaults to the genesis tool's)" )(
+      GENESIS_FORMAT_OPTION,
+      boost::program_options::value< std::string >()->default_value( "auto" ),
+      "format of the genesis file, 'auto', 'json' or 'binary'" )(
+      INPUT_FORMAT_OPTION "," INPUT_FORMAT_FLAG,
+      boost::program_options::value< std::string >()->default_value( "compact" ),
+      "input format: json, compact, binary or base64" )(
+      OUTPUT_FORMAT_OPTION "," OUTPUT_FORMAT_FLAG,
+      boost::program_options::value< std::string >()->default_value( "compact" ),
+      "transaction output format with --" SET_RC_LIMIT_OPTION ": json, compact, binary or base64" )(
+      SET_RC_LIMIT_OPTION "," SET_RC_LIMIT_FLAG,
+      "write each transaction with its rc_limit set to the estimate instead of the estimate" )(
+      MARGIN_OPTION "," MARGIN_FLAG,
+      boost::program_options::value< double >()->default_value( 10.0 ),
+      "percentage added to the estimated rc for the rc_limit" )(
+      CALL_COMPUTE_OPTION,
+      boost::program_options::value< uint64_t >()->default_value( 0 ),
+      "compute charged for the contract code run by each call_contract operation" )(
+      SIGNATURES_OPTION "," SIGNATURES_FLAG,
+      boost::program_options::value< std::size_t >()->default_value( 1 ),
+      "number of signatures each transaction will carry once signed" )(
+      THREADS_OPTION "," THREADS_FLAG,
+      boost::program_options::value< std::size_t >()->default_value( 1 ),
+      "number of estimating threads, 0 uses all cores" );
+
+    tools::add_stats_options( options );
+
+    // Parse command-line options
+    boost::program_options::variables_map vm;
+    boost::program_options::store( boost::program_options::parse_command_line( argc, argv, options ), vm );
+
+    // Handle help message
+    if( vm.count( HELP_OPTION ) )
+    {
+      std::cout << "Koinos RC Estimator" << std::endl;
+      std::cout << "Accepts transactions via STDIN and estimates their resource usage and rc without applying them"
+                << std::endl;
+      std::cout << "Returns one estimate per record via STDOUT, or with --" SET_RC_LIMIT_OPTION " one transaction"
+                << std::endl
+                << std::endl;
+      std::cout << options << std::endl;
+      return EXIT_SUCCESS;
+    }
+
+    auto stats = tools::make_stats_reporter( vm, "koinos_rc_estimator" );
+
+    auto num_threads  = vm[ THREADS_OPTION ].as< std::size_t >();
+    auto signatures   = vm[ SIGNATURES_OPTION ].as< std::size_t >();
+    bool set_rc_limit = vm.count( SET_RC_LIMIT_OPTION );
+
+    if( !num_threads )
+      num_threads = tools::ordered_executor< std::string, estimate_result >::default_concurrency();
+
+    auto input_format  = tools::parse_record_format( vm[ INPUT_FORMAT_OPTION ].as< std::string >() );
+    auto output_format = tools::parse_record_format( vm[ OUTPUT_FORMAT_OPTION ].as< std::string >() );
+    auto opts          = tools::make_record_options( input_format, output_format );
+
+    auto estimator = tools::rc_estimator();
+
+    if( vm.count( GENESIS_OPTION ) )
+    {
+      auto filename = vm[ GENESIS_OPTION ].as< std::string >();
+      std::ifstream stream( filename, std::ios::binary );
+      if( !stream )
+        throw std::runtime_error( "unable to open genesis file " + filename );
+
+      estimator = tools::rc_estimator::from_genesis(
+        stream,
+        tools::parse_genesis_format( vm[ GENESIS_FORMAT_OPTION ].as< std::string >() ) );
+    }
+
+    estimator.set_margin( vm[ MARGIN_OPTION ].as< double >() );
+    estimator.set_call_compute( vm[ CALL_COMPUTE_OPTION ].as< uint64_t >() );
+
+    std::ios::sync_with_stdio( false );
+    std::cin.tie( nullptr );
+
+    tools::record_reader reader( opts.input );
+    tools::output_flusher flusher;
+    std::string record;
+    uint64_t records               = 0;
+    std::atomic< uint64_t > errors = 0;
+
+    // Each worker reuses its own transaction across records
+    std::vector< protocol::transaction > transactions( num_threads );
+
+    auto start = std::chrono::steady_clock::now();
+
+    tools::ordered_executor< std::string, estimate_result > executor(
+      num_threads,
+      num_threads * ESTIMATE_QUEUE_DEPTH_PER_THREAD,
+      [ & ]( std::string& input, std::size_t worker )
+      {
+        auto result = estimate_record( estimator, input, opts, signatures, set_rc_limit, transactions[ worker ] );
+        if( !result.success )
+          errors++;
+        return result;
+      },
+      [ & ]( estimate_result& result )
+      {
+        tools::stage_timer timer( tools::stage::write );
+        tools::add_stage_bytes( tools::stage::write, result.output.size() );
+        std::cout.write( result.output.data(), result.output.size() );
+
+        if( flusher.record_written() )
+          std::cout.flush();
+      } );
+
+    while( reader.next( record ) )
+    {
+      records++;
+      flusher.record_read( reader.caught_up() );
+      executor.push( std::move( record ) );
+    }
+
+    executor.finish();
+    std::cout.flush();
+
+    auto elapsed = std::chrono::duration< double >( std::chrono::steady_clock::now() - start ).count();
+    LOG( info ) << "Estimated " << records << " transactions in " << elapsed << "s ("
+                << ( elapsed > 0 ? uint64_t( records / elapsed ) : 0 ) << " transactions/s) on " << num_threads
+                << " threads";
+
+    if( errors )
+    {
+      LOG( warning ) << errors << " of " << records << " transactions failed";
+      return EXIT_FAILURE;
+    }
+
+    return EXIT_SUCCESS;
+  }
+  catch( const boost::exception& e )
+  {
+    LOG( fatal ) << boost::diagnostic_information( e ) << std::endl;
+  }
+  catch( const std::exception& e )
+  {
+    LOG( fatal ) << e.what() << std::endl;
+  }
+  catch( ... )
+  {
+    LOG( fatal ) << "unknown exception" << std::endl;
+  }
+
+  return EXIT_FAILURE;
+}
@@ -0,0 +1,651 @@
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <filesystem>
+#include <future>
+#include <iostream>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include <unistd.h>
+
+#include <boost/asio.hpp>
+#include <boost/asio/local/stream_protocol.hpp>
+#include <boost/program_options.hpp>
+
+#include <koinos/crypto/elliptic.hpp>
+#include <koinos/exception.hpp>
+#include <koinos/log.hpp>
+#include <koinos/mq/request_handler.hpp>
+
+#include <koinos/tools/latency_histogram.hpp>
+#include <koinos/tools/records.hpp>
+#include <koinos/tools/signing.hpp>
+#include <koinos/tools/stats.hpp>
+
+// Command line option definitions
+#define HELP_OPTION "help"
+#define HELP_FLAG   "h"
+
+#define PRIVATE_KEY_OPTION "private-key"
+#define PRIVATE_KEY_FLAG   "p"
+
+#define KEYRING_OPTION "keyring"
+#define KEYRING_FLAG   "k"
+
+#define SOCKET_OPTION "socket"
+#define SOCKET_FLAG   "s"
+
+#define AMQP_OPTION "amqp"
+#define AMQP_FLAG   "a"
+
+#define AMQP_SERVICE_OPTION "amqp-service"
+
+#define FORMAT_OPTION "format"
+#define FORMAT_FLAG   "f"
+
+#define WRAP_OPTION "wrap"
+#define WRAP_FLAG   "w"
+
+#define FINALIZE_OPTION "finalize"
+
+#define THREADS_OPTION "threads"
+#define THREADS_FLAG   "t"
+
+#define BATCH_SIZE_OPTION "batch-size"
+#define BATCH_SIZE_FLAG   "b"
+
+#define STATS_INTERVAL_OPTION "stats-interval"
+
+#define LOG_LEVEL_OPTION "log-level"
+#define LOG_LEVEL_FLAG   "l"
+
+// Responses a connection may have outstanding before it stops reading requests
+const std::size_t CONNECTION_PIPELINE_DEPTH = 1'024;
+
+// Bytes of responses a connection accumulates before writing them while the client still has requests outstanding
+const std::size_t WRITE_BUFFER_SIZE = 64 * 1'024;
+
+using namespace koinos;
+using namespace koinos::tools;
+using local_protocol = boost::asio::local::stream_protocol;
+
+// Signs records submitted from any number of connections on a fixed pool of workers.
+//
+// A worker takes its share of the queued requests at once, up to the batch size, so a burst is spread across the
+// pool instead of being signed in turn by whichever worker woke first.
+class signing_service
+{
+public:
+  signing_service( std::vector< crypto::private_key > keys, std::size_t num_threads, std::size_t batch_size ):
+      _keys( std::move( keys ) ),
+      _batch_size( std::max< std::size_t >( batch_size, 1 ) ),
+      _num_threads( std::max< std::size_t >( num_threads, 1 ) )
+  {
+    for( std::size_t i = 0; i < _num_threads; i++ )
+      _workers.emplace_back( &signing_service::worker_main, this );
+  }
+
+  ~signing_service()
+  {
+    stop();
+  }
+
+  // Queue a record for signing, the returned future holds the output record
+  std::future< std::string > submit( std::string record, uint64_t position, const record_options& opts )
+  {
+    request req;
+    req.job.record   = std::move( record );
+    req.job.position = position;
+    req.opts         = &opts;
+    req.received     = std::chrono::steady_clock::now();
+    auto result      = req.response.get_future();
+
+    {
+      std::lock_guard lock( _mutex );
+      _queue.emplace_back( std::move( req ) );
+    }
+
+    _cv.notify_one();
+    return result;
+  }
+
+  void stop()
+  {
+    {
+      std::lock_guard lock( _mutex );
+      _stopped = true;
+    }
+
+    _cv.notify_all();
+
+    for( auto& worker: _workers )
+    {
+      if( worker.joinable() )
+        worker.join();
+    }
+  }
+
+  // Log throughput and latency since the last report
+  void report()
+  {
+    auto now     = std::chrono::steady_clock::now();
+    auto elapsed = std::chrono::duration< double >( now - _last_report ).count();
+    _last_report = now;
+
+    auto requests = _latency.count();
+    auto batches  = _batches.exchange( 0 );
+    auto errors   = _errors.exchange( 0 );
+
+    if( !requests )
+      return;
+
+    LOG( info ) << "Signed " << requests << " requests (" << uint64_t( requests / elapsed ) << "/s, " << errors
+                << " errors) in " << batches << " batches, latency p50 "
+                << std::chrono::duration_cast< std::chrono::microseconds >( _latency.percentile( 0.5 ) ).count()
+                << "us p99 "
+                << std::chrono::duration_cast< std::chrono::microseconds >( _latency.percentile( 0.99 ) ).count()
+                << "us max "
+                << std::chrono::duration_cast< std::chrono::microseconds >( _latency.max() ).count() << "us";
+
+    _latency.reset();
+  }
+
+private:
+  struct request
+  {
+    sign_job job;
+    const record_options* opts = nullptr;
+    std::chrono::steady_clock::time_point received;
+    std::promise< std::string > response;
+  };
+
+  void worker_main()
+  {
+    sign_context ctx;
+    std::vector< request > batch;
+    batch.reserve( _batch_size );
+
+    for( ;; )
+    {
+      {
+        std::unique_lock lock( _mutex );
+        _cv.wait( lock,
+                  [ & ]()
+                  {
+                    return !_queue.empty() || _stopped;
+                  } );
+
+        if( _queue.empty() )
+          return;
+
+        auto share = std::min( ( _queue.size() + _num_threads - 1 ) / _num_threads, _batch_size );
+
+        for( std::size_t i = 0; i < share; i++ )
+        {
+          batch.emplace_back( std::move( _queue.front() ) );
+          _queue.pop_front();
+        }
+
+        // Wake another worker for the rest rather than leaving them until this batch is signed
+        if( !_queue.empty() )
+          _cv.notify_one();
+      }
+
+      _batches++;
+
+      for( auto& req: batch )
+      {
+        std::string output;
+
+        if( !sign_record( req.job, _keys, *req.opts, ctx, output ) )
+          _errors++;
+
+        req.response.set_value( std::move( output ) );
+        _latency.record( std::chrono::steady_clock::now() - req.received );
+      }
+
+      batch.clear();
+    }
+  }
+
+  const std::vector< crypto::private_key > _keys;
+  const std::size_t _batch_size;
+  const std::size_t _num_threads;
+
+  std::mutex _mutex;
+  std::condition_variable _cv;
+  std::deque< request > _queue;
+  std::vector< std::thread > _workers;
+  bool _stopped = false;
+
+  latency_histogram _latency;
+  std::atomic< uint64_t > _batches = 0;
+  std::atomic< uint64_t > _errors  = 0;
+  std::chrono::steady_clock::time_point _last_report = std::chrono::steady_clock::now();
+};
+
+// A client of the Unix socket. Requests are read and submitted on one thread while responses are written
+// in request order on another, so a client may pipeline requests.
+class connection
+{
+public:
+  connection( local_protocol::socket socket, signing_service& service, const record_options& opts ):
+      _write_socket( socket.get_executor() ),
+      _service( service ),
+      _opts( opts )
+  {
+    // Responses are written through a duplicate of the socket, the iostream is only safe to use from the reading thread
+    _write_socket.assign( local_protocol(), ::dup( socket.native_handle() ) );
+    _stream = local_protocol::iostream( std::move( socket ) );
+  }
+
+  void start()
+  {
+    _reader = std::thread( &connection::read_main, this );
+    _writer = std::thread( &connection::write_main, this );
+  }
+
+  void close()
+  {
+    boost::system::error_code ec;
+    _write_socket.shutdown( local_protocol::socket::shutdown_both, ec );
+  }
+
+  void join()
+  {
+    if( _reader.joinable() )
+      _reader.join();
+    if( _writer.joinable() )
+      _writer.join();
+  }
+
+  bool finished()
+  {
+    std::lock_guard lock( _mutex );
+    return _finished;
+  }
+
+private:
+  void read_main()
+  {
+    record_reader reader( _opts.input, _stream );
+    std::string record;
+
+    try
+    {
+      while( reader.next( record ) )
+      {
+        auto response = _service.submit( std::move( record ), reader.position(), _opts );
+        record        = std::string();
+
+        std::unique_lock lock( _mutex );
+        _space_cv.wait( lock,
+                        [ & ]()
+                        {
+                          return _pending.size() < CONNECTION_PIPELINE_DEPTH;
+                        } );
+        _pending.emplace_back( std::move( response ) );
+        _pending_cv.notify_one();
+      }
+    }
+    catch( const std::exception& e )
+    {
+      LOG( warning ) << "Closing connection: " << e.what();
+    }
+
+    std::lock_guard lock( _mutex );
+    _eof = true;
+    _pending_cv.notify_one();
+  }
+
+  void write_main()
+  {
+    std::string buffer;
+    boost::system::error_code ec;
+
+    for( ;; )
+    {
+      std::future< std::string > response;
+      bool caught_up = false;
+
+      {
+        std::unique_lock lock( _mutex );
+        _pending_cv.wait( lock,
+                          [ & ]()
+                          {
+                            return !_pending.empty() || _eof;
+                          } );
+
+        if( _pending.empty() )
+          break;
+
+        response = std::move( _pending.front() );
+        _pending.pop_front();
+        caught_up = _pending.empty();
+        _space_cv.notify_one();
+      }
+
+      buffer += response.get();
+
+      // Write once the client has no further responses outstanding or enough have accumulated
+      if( !ec && ( caught_up || buffer.size() >= WRITE_BUFFER_SIZE ) )
+      {
+        stage_timer timer( stage::write );
+        add_stage_bytes( stage::write, buffer.size() );
+        boost::asio::write( _write_socket, boost::asio::buffer( buffer ), ec );
+        buffer.clear();
+      }
+    }
+
+    if( !ec && !buffer.empty() )
+    {
+      stage_timer timer( stage::write );
+      add_stage_bytes( stage::write, buffer.size() );
+      boost::asio::write( _write_socket, boost::asio::buffer( buffer ), ec );
+    }
+
+    if( ec )
+      LOG( warning ) << "Error writing to connection: " << ec.message();
+
+    close();
+
+    std::lock_guard lock( _mutex );
+    _finished = true;
+  }
+
+  local_protocol::socket _write_socket;
+  local_protocol::iostream _stream;
+  signing_service& _service;
+  const record_options& _opts;
+
+  std::thread _reader;
+  std::thread _writer;
+  std::mutex _mutex;
+  std::condition_variable _pending_cv;
+  std::condition_variable _space_cv;
+  std::deque< std::future< std::string > > _pending;
+  bool _eof      = false;
+  bool _finished = false;
+};
+
+// Accepts connections on the Unix socket and reaps those that have closed
+class socket_server
+{
+public:
+  socket_server( boost::asio::io_context& ioc,
+                 const std::filesystem::path& path,
+                 signing_service& service,
+                 const record_options& opts ):
+      _acceptor( ioc ),
+      _service( service ),
+      _opts( opts )
+  {
+    std::filesystem::remove( path );
+
+    local_protocol::endpoint endpoint( path.string() );
+    _acceptor.open( endpoint.protocol() );
+    _acceptor.bind( endpoint );
+    _acceptor.listen();
+
+    accept();
+  }
+
+  void stop()
+  {
+    boost::system::error_code ec;
+    _acceptor.close( ec );
+
+    for( auto& conn: _connections )
+      conn->close();
+
+    for( auto& conn: _connections )
+      conn->join();
+
+    _connections.clear();
+  }
+
+private:
+  void accept()
+  {
+    _acceptor.async_accept(
+      [ this ]( const boost::system::error_code& ec, local_protocol::socket socket )
+      {
+        if( ec )
+        {
+          if( ec != boost::asio::error::operation_aborted )
+            LOG( error ) << "Error accepting connection: " << ec.message();
+          return;
+        }
+
+        reap();
+
+        _connections.emplace_back( std::make_unique< connection >( std::move( socket ), _service, _opts ) );
+        _connections.back()->start();
+
+        accept();
+      } );
+  }
+
+  void reap()
+  {
+    for( auto itr = _connections.begin(); itr != _connections.end(); )
+    {
+      if( ( *itr )->finished() )
+      {
+        ( *itr )->join();
+        itr = _connections.erase( itr );
+      }
+      else
+      {
+        ++itr;
+      }
+    }
+  }
+
+  local_protocol::acceptor _acceptor;
+  signing_service& _service;
+  const record_options& _opts;
+  std::list< std::unique_ptr< connection > > _connections;
+};
+
+int main( int argc, char** argv )
+{
+  try
+  {
+    // Setup command line options
+    boost::program_options::options_description options( "Options" );
+    options.add_options()( HELP_OPTION "," HELP_FLAG, "print usage message" )(
+      PRIVATE_KEY_OPTION "," PRIVATE_KEY_FLAG,
+      boost::program_options::value< std::vector< std::string > >()->composing()->default_value(
+        { "private.key" },
+        "private.key" ),
+      "private key file, repeat to sign with several keys" )(
+      KEYRING_OPTION "," KEYRING_FLAG,
+      boost::program_options::value< std::string >(),
+      "file of WIF private keys, one per line, to sign with instead of private key files" )(
+      SOCKET_OPTION "," SOCKET_FLAG,
+      boost::program_options::value< std::string >()->default_value( "koinos_signer.sock" ),
+      "Unix socket to serve sign requests on" )( AMQP_OPTION "," AMQP_FLAG,
+                                                 boost::program_options::value< std::string >(),
+                                                 "also serve sign requests over AMQP at the given url" )(
+      AMQP_SERVICE_OPTION,
+      boost::program_options::value< std::string >()->default_value( "koinos_signer" ),
+      "AMQP rpc service name" )( FORMAT_OPTION "," FORMAT_FLAG,
+                                 boost::program_options::value< std::string >()->default_value( "binary" ),
+                                 "socket record format: json, compact, binary or base64" )(
+      WRAP_OPTION "," WRAP_FLAG,
+      "wrap signed transactions in a request" )( FINALIZE_OPTION,
+                                                 "compute the operation merkle root of transactions before signing" )(
+      THREADS_OPTION "," THREADS_FLAG,
+      boost::program_options::value< std::size_t >()->default_value( 0 ),
+      "number of signing threads, 0 uses all cores" )(
+      BATCH_SIZE_OPTION "," BATCH_SIZE_FLAG,
+      boost::program_options::value< std::size_t >()->default_value( 64 ),
+      "maximum number of queued requests a signing thread takes at once" )(
+      STATS_INTERVAL_OPTION,
+      boost::program_options::value< uint32_t >()->default_value( 10 ),
+      "seconds between throughput and latency reports, 0 to disable" )(
+      LOG_LEVEL_OPTION "," LOG_LEVEL_FLAG,
+      boost::program_options::value< std::string >()->default_value( "info" ),
+      "log level" );
+
+    add_stats_options( options );
+
+    // Parse command-line options
+    boost::program_options::variables_map vm;
+    boost::program_options::store( boost::program_options::parse_command_line( argc, argv, options ), vm );
+
+    // Handle help message
+    if( vm.count( HELP_OPTION ) )
+    {
+      std::cout << "Koinos Signer Daemon" << std::endl;
+      std::cout << "Holds private keys in memory and signs transactions sent over a Unix socket or AMQP" << std::endl;
+      std::cout << "Socket clients send one transaction per record and receive one result per record, in order"
+                << std::endl;
+      std::cout << "AMQP requests are a serialized transaction, responses the serialized signed transaction"
+                << std::endl
+                << std::endl;
+      std::cout << options << std::endl;
+      return EXIT_SUCCESS;
+    }
+
+    koinos::initialize_logging( "koinos_signer_daemon", {}, vm[ LOG_LEVEL_OPTION ].as< std::string >() );
+
+    auto stats = make_stats_reporter( vm, "koinos_signer_daemon" );
+
+    // Read options into variables
+    auto key_filenames  = vm[ PRIVATE_KEY_OPTION ].as< std::vector< std::string > >();
+    auto socket_path    = std::filesystem::path( vm[ SOCKET_OPTION ].as< std::string >() );
+    auto num_threads    = vm[ THREADS_OPTION ].as< std::size_t >();
+    auto batch_size     = vm[ BATCH_SIZE_OPTION ].as< std::size_t >();
+    auto stats_interval = std::chrono::seconds( vm[ STATS_INTERVAL_OPTION ].as< uint32_t >() );
+
+    if( !num_threads )
+      num_threads = std::max< std::size_t >( std::thread::hardware_concurrency(), 1 );
+
+    auto format      = parse_record_format( vm[ FORMAT_OPTION ].as< std::string >() );
+    auto socket_opts = make_record_options( format, format == record_format::json ? record_format::compact : format );
+    socket_opts.wrap     = vm.count( WRAP_OPTION );
+    socket_opts.finalize = vm.count( FINALIZE_OPTION );
+
+    // AMQP messages are framed by the broker
+    auto amqp_opts      = make_record_options( record_format::binary, record_format::binary );
+    amqp_opts.wrap      = socket_opts.wrap;
+    amqp_opts.finalize  = socket_opts.finalize;
+    amqp_opts.delimited = false;
+
+    // Read the keyfiles
+    std::vector< crypto::private_key > signing_keys;
+
+    if( vm.count( KEYRING_OPTION ) )
+    {
+      signing_keys = read_keyring( vm[ KEYRING_OPTION ].as< std::string >() );
+    }
+    else
+    {
+      for( const auto& key_filename: key_filenames )
+        signing_keys.emplace_back( read_keyfile( key_filename ) );
+    }
+
+    if( signing_keys.empty() )
+      throw std::runtime_error( "no private keys to sign with" );
+
+    signing_service service( std::move( signing_keys ), num_threads, batch_size );
+
+    boost::asio::io_context ioc;
+    socket_server server( ioc, socket_path, service, socket_opts );
+
+    LOG( info ) << "Serving sign requests on " << socket_path.string() << " with " << num_threads << " threads";
+
+    std::unique_ptr< mq::request_handler > request_handler;
+    std::atomic< uint64_t > amqp_requests = 0;
+
+    if( vm.count( AMQP_OPTION ) )
+    {
+      auto amqp_service = vm[ AMQP_SERVICE_OPTION ].as< std::string >();
+      request_handler   = std::make_unique< mq::request_handler >( ioc );
+      request_handler->add_rpc_handler( amqp_service,
+                                        [ & ]( const std::string& payload ) -> std::string
+                                        {
+                                          return service.submit( payload, ++amqp_requests, amqp_opts ).get();
+                                        } );
+      request_handler->connect( vm[ AMQP_OPTION ].as< std::string >() );
+
+      LOG( info ) << "Serving sign requests over AMQP as " << amqp_service;
+    }
+
+    boost::asio::steady_timer stats_timer( ioc );
+    std::function< void() > schedule_report = [ & ]()
+    {
+      stats_timer.expires_after( stats_interval );
+      stats_timer.async_wait(
+        [ & ]( const boost::system::error_code& ec )
+        {
+          if( ec )
+            return;
+
+          service.report();
+          schedule_report();
+        } );
+    };
+
+    if( stats_interval.count() )
+      schedule_report();
+
+    boost::asio::signal_set signals( ioc, SIGINT, SIGTERM );
+    signals.async_wait(
+      [ & ]( const boost::system::error_code&, int )
+      {
+        LOG( info ) << "Caught signal, shutting down";
+        ioc.stop();
+      } );
+
+    // AMQP handlers block on signing results, so they need threads of their own
+    std::vector< std::thread > io_threads;
+
+    if( request_handler )
+    {
+      for( std::size_t i = 1; i < num_threads; i++ )
+        io_threads.emplace_back(
+          [ & ]()
+          {
+            ioc.run();
+          } );
+    }
+
+    ioc.run();
+
+    for( auto& thread: io_threads )
+      thread.join();
+
+    if( request_handler )
+      request_handler->disconnect();
+
+    server.stop();
+    service.stop();
+    service.report();
+
+    std::filesystem::remove( socket_path );
+
+    return EXIT_SUCCESS;
+  }
+  catch( const boost::exception& e )
+  {
+    LOG( fatal ) << boost::diagnostic_information( e ) << std::endl;
+  }
+  catch( const std::exception& e )
+  {
+    LOG( fatal ) << e.what() << std::endl;
+  }
+  catch( ... )
+  {
+    LOG( fatal ) << "unknown exception" << std::endl;
+  }
+
+  return EXIT_FAILURE;
+}
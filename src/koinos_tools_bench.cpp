@@ -0,0 +1,435 @@
+#include <chrono>
+#include <deque>
+#include <fstream>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <optional>
+#include <string>
+#include <vector>
+
+#include <boost/program_options.hpp>
+
+#include <google/protobuf/util/json_util.h>
+
+#include <nlohmann/json.hpp>
+
+#include <koinos/crypto/elliptic.hpp>
+#include <koinos/crypto/merkle_tree.hpp>
+#include <koinos/crypto/multihash.hpp>
+#include <koinos/exception.hpp>
+#include <koinos/log.hpp>
+#include <koinos/util/base58.hpp>
+#include <koinos/util/base64.hpp>
+#include <koinos/util/conversion.hpp>
+
+#include <koinos/tools/latency_histogram.hpp>
+#include <koinos/tools/merkle_tree.hpp>
+#include <koinos/tools/signing.hpp>
+#include <koinos/tools/stats.hpp>
+#include <koinos/tools/transaction.hpp>
+
+// Command line option definitions
+#define HELP_OPTION "help"
+#define HELP_FLAG   "h"
+
+#define DURATION_OPTION "duration"
+#define DURATION_FLAG   "d"
+
+#define FILTER_OPTION "filter"
+#define FILTER_FLAG   "f"
+
+#define JSON_OPTION "json"
+#define JSON_FLAG   "j"
+
+#define BASELINE_OPTION "baseline"
+#define BASELINE_FLAG   "b"
+
+#define THRESHOLD_OPTION "threshold"
+
+#define LIST_OPTION "list"
+#define LIST_FLAG   "l"
+
+// Iterations run before measuring each benchmark
+const uint64_t WARMUP_ITERATIONS = 16;
+
+// Leaves in the large merkle tree benchmark, about a block's worth of transactions
+const std::size_t MERKLE_LEAVES = 1'024;
+
+using namespace koinos;
+
+struct benchmark
+{
+  std::string name;
+  std::function< void() > operation;
+};
+
+struct benchmark_result
+{
+  std::string name;
+  uint64_t iterations   = 0;
+  double ops_per_second = 0;
+  tools::latency_histogram latency;
+};
+
+// Results are accumulated here so the compiler cannot discard the benchmarked operations
+volatile std::size_t benchmark_sink = 0;
+
+template< typename T >
+void consume( const T& value )
+{
+  benchmark_sink = benchmark_sink + value.size();
+}
+
+std::vector< benchmark > make_benchmarks()
+{
+  auto private_key =
+    crypto::private_key::regenerate( crypto::hash( crypto::multicodec::sha2_256, std::string( "bench" ) ) );
+  auto wif         = private_key.to_wif();
+  auto address     = private_key.get_public_key().to_address_bytes();
+  auto secret      = crypto::hash( crypto::multicodec::sha2_256, std::string( "secret" ) );
+
+  // A transaction like the ones the signer handles: one contract call with a token transfer sized payload
+  protocol::transaction transaction;
+  auto header = transaction.mutable_header();
+  header->set_chain_id(
+    util::converter::as< std::string >( crypto::hash( crypto::multicodec::sha2_256, std::string( "chain" ) ) ) );
+  header->set_rc_limit( 100'000'000 );
+  header->set_nonce( tools::encode_nonce( 1 ) );
+  header->set_payer( address );
+
+  auto call = transaction.add_operations()->mutable_call_contract();
+  call->set_contract_id( address );
+  call->set_entry_point( 0x27f576ca );
+  call->set_args( std::string( 72, 'a' ) );
+
+  tools::finalize_transaction( transaction );
+  tools::sign_transaction( transaction, { private_key } );
+
+  auto digest    = crypto::hash( crypto::multicodec::sha2_256, transaction.header() );
+  auto signature = private_key.sign_compact( digest );
+
+  std::string signature_bytes( reinterpret_cast< const char* >( signature.data() ), signature.size() );
+  auto signature_base64 = util::to_base64< std::string >( signature_bytes );
+  auto address_base58   = util::to_base58( address );
+
+  std::string json;
+  google::protobuf::util::MessageToJsonString( transaction, &json );
+
+  std::string proof_input    = util::converter::as< std::string >( digest );
+  auto [ proof, proof_hash ] = private_key.generate_random_proof( proof_input );
+
+  std::vector< crypto::multihash > leaves;
+  leaves.reserve( MERKLE_LEAVES );
+  for( uint64_t i = 0; i < MERKLE_LEAVES; i++ )
+    leaves.emplace_back( crypto::hash( crypto::multicodec::sha2_256, i ) );
+
+  auto operation_hashes = tools::hash_operations( transaction );
+
+  return {
+    { "sha2_256_header",
+     [ = ]()
+     {
+       consume( crypto::hash( crypto::multicodec::sha2_256, transaction.header() ).digest() );
+     } },
+    { "sign_compact",
+     [ = ]()
+     {
+       consume( private_key.sign_compact( digest ) );
+     } },
+    { "public_key_recover",
+     [ = ]()
+     {
+       consume( crypto::public_key::recover( signature, digest ).serialize() );
+     } },
+    { "private_key_from_wif",
+     [ = ]()
+     {
+       consume( crypto::private_key::from_wif( wif ).get_secret() );
+     } },
+    { "private_key_regenerate",
+     [ = ]()
+     {
+       consume( crypto::private_key::regenerate( secret ).get_secret() );
+     } },
+    { "generate_random_proof",
+     [ = ]()
+     {
+       consume( private_key.generate_random_proof( proof_input ).first );
+     } },
+    { "verify_random_proof",
+     [ = ]()
+     {
+       consume( private_key.get_public_key().verify_random_proof( proof_input, proof ).digest() );
+     } },
+    { "operation_merkle_root",
+     [ = ]()
+     {
+       consume( tools::operation_merkle_root( operation_hashes ).digest() );
+     } },
+    { "merkle_tree_1024",
+     [ = ]()
+     {
+       consume( crypto::merkle_tree( crypto::multicodec::sha2_256, leaves ).root()->hash().digest() );
+     } },
+    { "flat_merkle_tree_1024",
+     [ = ]()
+     {
+       consume( tools::merkle_tree( crypto::multicodec::sha2_256, leaves ).root().digest() );
+     } },
+    { "flat_merkle_tree_replace",
+     [ tree  = tools::merkle_tree( crypto::multicodec::sha2_256, leaves ),
+       leaf  = leaves.front(),
+       index = std::size_t( 0 ) ]() mutable
+     {
+       tree.replace( index++ % MERKLE_LEAVES, leaf );
+       consume( tree.root().digest() );
+     } },
+    { "base58_encode",
+     [ = ]()
+     {
+       consume( util::to_base58( address ) );
+     } },
+    { "base58_decode",
+     [ = ]()
+     {
+       consume( util::from_base58< std::string >( address_base58 ) );
+     } },
+    { "base64_encode",
+     [ = ]()
+     {
+       consume( util::to_base64< std::string >( signature_bytes ) );
+     } },
+    { "base64_decode",
+     [ = ]()
+     {
+       consume( util::from_base64< std::string >( signature_base64 ) );
+     } },
+    { "json_print_transaction",
+     [ = ]()
+     {
+       std::string output;
+       google::protobuf::util::MessageToJsonString( transaction, &output );
+       consume( output );
+     } },
+    { "json_parse_transaction",
+     [ = ]()
+     {
+       protocol::transaction parsed;
+       google::protobuf::util::JsonStringToMessage( json, &parsed );
+       consume( parsed.signatures() );
+     } },
+  };
+}
+
+void run_benchmark( const benchmark& bench, std::chrono::nanoseconds duration, benchmark_result& result )
+{
+  result.name = bench.name;
+
+  for( uint64_t i = 0; i < WARMUP_ITERATIONS; i++ )
+    bench.operation();
+
+  auto start = std::chrono::steady_clock::now();
+  auto end   = start;
+
+  // Always measure at least one iteration so slow operations with short durations still report
+  do
+  {
+    auto op_start = std::chrono::steady_clock::now();
+    bench.operation();
+    end = std::chrono::steady_clock::now();
+
+    result.latency.record( end - op_start );
+    result.iterations++;
+  }
+  while( end - start < duration );
+
+  result.ops_per_second = result.iterations / std::chrono::duration< double >( end - start ).count();
+}
+
+nlohmann::json to_json( const benchmark_result& result )
+{
+  return {
+    {           "name",                                 result.name },
+    {     "iterations",                           result.iterations },
+    { "ops_per_second",                       result.ops_per_second },
+    {        "mean_ns",              result.latency.mean().count() },
+    {         "p50_ns", result.latency.percentile( 0.50 ).count() },
+    {         "p90_ns", result.latency.percentile( 0.90 ).count() },
+    {         "p99_ns", result.latency.percentile( 0.99 ).count() },
+    {         "max_ns",               result.latency.max().count() }
+  };
+}
+
+// Compare results to a previous --json run, returning the number of benchmarks that regressed by more than the
+// threshold
+uint64_t compare_results( const std::deque< benchmark_result >& results,
+                          const std::string& baseline_filename,
+                          double threshold,
+                          std::ostream& out )
+{
+  std::ifstream baseline_stream( baseline_filename );
+  if( !baseline_stream )
+    throw std::runtime_error( "unable to open baseline file " + baseline_filename );
+
+  auto baseline = nlohmann::json::parse( baseline_stream );
+
+  uint64_t regressions = 0;
+
+  out << "\n"
+      << std::left << std::setw( 26 ) << "benchmark" << std::right << std::setw( 14 ) << "baseline ops/s"
+      << std::setw( 14 ) << "ops/s" << std::setw( 10 ) << "change" << "\n";
+
+  for( const auto& result: results )
+  {
+    std::optional< double > baseline_ops;
+    for( const auto& entry: baseline[ "benchmarks" ] )
+    {
+      if( entry[ "name" ] == result.name )
+        baseline_ops = entry[ "ops_per_second" ].get< double >();
+    }
+
+    out << std::left << std::setw( 26 ) << result.name << std::right;
+
+    if( !baseline_ops || *baseline_ops <= 0 )
+    {
+      out << std::setw( 14 ) << "-" << std::setw( 14 ) << uint64_t( result.ops_per_second ) << "\n";
+      continue;
+    }
+
+    double change  = ( result.ops_per_second - *baseline_ops ) / *baseline_ops * 100;
+    bool regressed = change < -threshold;
+    if( regressed )
+      regressions++;
+
+    out << std::setw( 14 ) << uint64_t( *baseline_ops ) << std::setw( 14 ) << uint64_t( result.ops_per_second )
+        << std::setw( 9 ) << std::fixed << std::setprecision( 1 ) << change << "%"
+        << ( regressed ? "  REGRESSION" : "" ) << "\n";
+  }
+
+  out << std::flush;
+  return regressions;
+}
+
+int main( int argc, char** argv )
+{
+  try
+  {
+    // Setup command line options
+    boost::program_options::options_description options( "Options" );
+    options.add_options()( HELP_OPTION "," HELP_FLAG, "print usage message" )(
+      DURATION_OPTION "," DURATION_FLAG,
+      boost::program_options::value< double >()->default_value( 1.0 ),
+      "seconds to run each benchmark for" )( FILTER_OPTION "," FILTER_FLAG,
+                                             boost::program_options::value< std::string >()->default_value( "" ),
+                                             "only run benchmarks whose name contains this string" )(
+      JSON_OPTION "," JSON_FLAG,
+      "print results as JSON" )( BASELINE_OPTION "," BASELINE_FLAG,
+                                 boost::program_options::value< std::string >(),
+                                 "compare results to a previous --json run, failing on regressions" )(
+      THRESHOLD_OPTION,
+      boost::program_options::value< double >()->default_value( 10.0 ),
+      "percentage drop in ops/s from the baseline that counts as a regression" )( LIST_OPTION "," LIST_FLAG,
+                                                                                  "list the benchmarks" );
+
+    tools::add_stats_options( options );
+
+    // Parse command-line options
+    boost::program_options::variables_map vm;
+    boost::program_options::store( boost::program_options::parse_command_line( argc, argv, options ), vm );
+
+    // Handle help message
+    if( vm.count( HELP_OPTION ) )
+    {
+      std::cout << "Koinos Tools Benchmark" << std::endl;
+      std::cout << "Measures the throughput and latency of the crypto and serialization operations used by the tools"
+                << std::endl
+                << std::endl;
+      std::cout << options << std::endl;
+      return EXIT_SUCCESS;
+    }
+
+    auto benchmarks = make_benchmarks();
+    auto filter     = vm[ FILTER_OPTION ].as< std::string >();
+    bool json       = vm.count( JSON_OPTION );
+    auto duration   = std::chrono::duration_cast< std::chrono::nanoseconds >(
+      std::chrono::duration< double >( vm[ DURATION_OPTION ].as< double >() ) );
+
+    if( vm.count( LIST_OPTION ) )
+    {
+      for( const auto& bench: benchmarks )
+        std::cout << bench.name << "\n";
+      return EXIT_SUCCESS;
+    }
+
+    // Stage timers inside the benchmarked operations add to their latency, compare runs with the same --stats setting
+    auto stats = tools::make_stats_reporter( vm, "koinos_tools_bench" );
+
+    // Results hold atomic histograms and cannot be moved, so they are kept in a deque
+    std::deque< benchmark_result > results;
+
+    if( !json )
+      std::cout << std::left << std::setw( 26 ) << "benchmark" << std::right << std::setw( 14 ) << "ops/s"
+                << std::setw( 12 ) << "mean ns" << std::setw( 12 ) << "p50 ns" << std::setw( 12 ) << "p90 ns"
+                << std::setw( 12 ) << "p99 ns" << std::setw( 12 ) << "max ns" << std::endl;
+
+    for( const auto& bench: benchmarks )
+    {
+      if( bench.name.find( filter ) == std::string::npos )
+        continue;
+
+      auto& result = results.emplace_back();
+      run_benchmark( bench, duration, result );
+
+      if( !json )
+        std::cout << std::left << std::setw( 26 ) << result.name << std::right << std::setw( 14 )
+                  << uint64_t( result.ops_per_second ) << std::setw( 12 ) << result.latency.mean().count()
+                  << std::setw( 12 ) << result.latency.percentile( 0.50 ).count() << std::setw( 12 )
+                  << result.latency.percentile( 0.90 ).count() << std::setw( 12 )
+                  << result.latency.percentile( 0.99 ).count() << std::setw( 12 ) << result.latency.max().count()
+                  << std::endl;
+    }
+
+    if( json )
+    {
+      nlohmann::json output = {
+        { "benchmarks", nlohmann::json::array() }
+      };
+      for( const auto& result: results )
+        output[ "benchmarks" ].push_back( to_json( result ) );
+
+      std::cout << output.dump( 2 ) << std::endl;
+    }
+
+    if( vm.count( BASELINE_OPTION ) )
+    {
+      auto regressions =
+        compare_results( results,
+                         vm[ BASELINE_OPTION ].as< std::string >(),
+                         vm[ THRESHOLD_OPTION ].as< double >(),
+                         json ? std::cerr : std::cout );
+
+      if( regressions )
+      {
+        LOG( error ) << regressions << " benchmarks regressed against the baseline";
+        return EXIT_FAILURE;
+      }
+    }
+
+    return EXIT_SUCCESS;
+  }
+  catch( const boost::exception& e )
+  {
+    LOG( fatal ) << boost::diagnostic_information( e ) << std::endl;
+  }
+  catch( const std::exception& e )
+  {
+    LOG( fatal ) << e.what() << std::endl;
+  }
+  catch( ... )
+  {
+    LOG( fatal ) << "unknown exception" << std::endl;
+  }
+
+  return EXIT_FAILURE;
+}
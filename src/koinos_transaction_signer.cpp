@@ -1,16 +1,31 @@
+#include <atomic>
+#include <cerrno>
+#include <cstdio>
 #include <fstream>
 #include <iostream>
+#include <iterator>
+#include <memory>
+#include <optional>
+#include <system_error>
 
-#include <boost/program_options.hpp>
+#include <fcntl.h>
+#include <unistd.h>
 
-#include <google/protobuf/message.h>
-#include <google/protobuf/util/json_util.h>
+#include <boost/program_options.hpp>
 
 #include <koinos/crypto/elliptic.hpp>
 #include <koinos/crypto/multihash.hpp>
 #include <koinos/exception.hpp>
 #include <koinos/log.hpp>
 #include <koinos/util/conversion.hpp>
+#include <koinos/util/hex.hpp>
+
+#include <koinos/tools/ordered_executor.hpp>
+#include <koinos/tools/records.hpp>
+#include <koinos/tools/resources.hpp>
+#include <koinos/tools/signing.hpp>
+#include <koinos/tools/stats.hpp>
+#include <koinos/tools/transaction.hpp>
 
 #include <koinos/protocol/protocol.pb.h>
 #include <koinos/rpc/chain/chain_rpc.pb.h>
@@ -25,40 +40,574 @@
 #define WRAP_OPTION "wrap"
 #define WRAP_FLAG   "w"
 
+#define UNWRAP_OPTION "unwrap"
+#define UNWRAP_FLAG   "u"
+
+#define STREAM_OPTION "stream"
+#define STREAM_FLAG   "s"
+
+#define THREADS_OPTION "threads"
+#define THREADS_FLAG   "t"
+
+#define INPUT_FORMAT_OPTION "input-format"
+#define INPUT_FORMAT_FLAG   "i"
+
+#define OUTPUT_FORMAT_OPTION "output-format"
+#define OUTPUT_FORMAT_FLAG   "o"
+
+#define FINALIZE_OPTION "finalize"
+#define FINALIZE_FLAG   "f"
+
+#define ASSIGN_NONCES_OPTION "assign-nonces"
+#define ASSIGN_NONCES_FLAG   "n"
+
+#define NONCE_FILE_OPTION "nonce-file"
+
+#define KEYRING_OPTION "keyring"
+#define KEYRING_FLAG   "k"
+
+#define MERGE_OPTION "merge"
+#define MERGE_FLAG   "m"
+
+#define ESTIMATE_RC_OPTION "estimate-rc"
+#define ESTIMATE_RC_FLAG   "e"
+
+#define RC_GENESIS_OPTION "rc-genesis"
+
+#define RC_MARGIN_OPTION "rc-margin"
+
+#define CALL_COMPUTE_OPTION "call-compute"
+
+#define INPUT_FILE_OPTION "input-file"
+
+#define OUTPUT_FILE_OPTION "output-file"
+
+#define CHECKPOINT_OPTION "checkpoint"
+
+#define CHECKPOINT_INTERVAL_OPTION "checkpoint-interval"
+
+// Records in flight per signing thread when streaming, bounds memory regardless of input size
+const std::size_t SIGNING_QUEUE_DEPTH_PER_THREAD = 256;
+
+// Output buffered before it is written to the output file between checkpoints
+const std::size_t OUTPUT_BUFFER_SIZE = 1 << 20;
+
 using namespace koinos;
+using namespace koinos::tools;
+
+// Parse the job's transaction and assign it a nonce, nonces must be assigned in input order
+void assign_job_nonce( const record_options& opts, nonce_tracker& nonces, sign_context& ctx, sign_job& job )
+{
+  try
+  {
+    read_transaction( job.record, opts, ctx );
+    nonces.assign( ctx.transaction );
+    job.transaction.emplace();
+    job.transaction->Swap( &ctx.transaction );
+  }
+  catch( const std::exception& e )
+  {
+    job.error = e.what();
+  }
+}
+
+// Read the next job from STDIN, assigning a nonce to its transaction if a nonce tracker is given
+bool read_job( record_reader& reader,
+               const record_options& opts,
+               nonce_tracker* nonces,
+               sign_context& ctx,
+               sign_job& job )
+{
+  job.transaction.reset();
+  job.error.clear();
+
+  if( !reader.next( job.record ) )
+    return false;
+
+  job.position = reader.position();
+
+  if( nonces )
+    assign_job_nonce( opts, *nonces, ctx, job );
+
+  return true;
+}
+
+// Sign records from STDIN until EOF, writing one result record per input record to STDOUT
+uint64_t sign_stream( const std::vector< crypto::private_key >& signing_keys,
+                      std::size_t num_threads,
+                      const record_options& opts,
+                      nonce_tracker* nonces )
+{
+  // Results are written from the signing workers while this thread reads, so reading
+  // STDIN must not flush STDOUT as it does when the streams are tied
+  std::cin.tie( nullptr );
+
+  record_reader reader( opts.input );
+  sign_context reader_ctx;
+  sign_job job;
+  output_flusher flusher;
+  uint64_t records               = 0;
+  std::atomic< uint64_t > errors = 0;
+
+  // Only flush once we have caught up with the producer to avoid a syscall per record
+  auto write_record = [ & ]( const std::string& output )
+  {
+    stage_timer timer( stage::write );
+    add_stage_bytes( stage::write, output.size() );
+    std::cout.write( output.data(), output.size() );
+
+    if( flusher.record_written() )
+      std::cout.flush();
+  };
+
+  if( num_threads <= 1 )
+  {
+    std::string output;
+
+    while( read_job( reader, opts, nonces, reader_ctx, job ) )
+    {
+      records++;
+      flusher.record_read( reader.caught_up() );
+
+      if( !sign_record( job, signing_keys, opts, reader_ctx, output ) )
+        errors++;
+
+      write_record( output );
+    }
+  }
+  else
+  {
+    std::vector< sign_context > contexts( num_threads );
+
+    ordered_executor< sign_job, std::string > executor(
+      num_threads,
+      num_threads * SIGNING_QUEUE_DEPTH_PER_THREAD,
+      [ & ]( sign_job& input, std::size_t worker )
+      {
+        std::string output;
+        if( !sign_record( input, signing_keys, opts, contexts[ worker ], output ) )
+          errors++;
+        return output;
+      },
+      write_record );
+
+    while( read_job( reader, opts, nonces, reader_ctx, job ) )
+    {
+      records++;
+      flusher.record_read( reader.caught_up() );
+      executor.push( std::move( job ) );
+      job = sign_job();
+    }
+
+    executor.finish();
+  }
+
+  std::cout.flush();
+
+  if( errors )
+    LOG( warning ) << "Failed to sign " << errors << " of " << records << " records";
+
+  return errors;
+}
+
+// Merge the signatures of partially signed copies of the same transactions. Each file holds the same
+// transactions in the same order, as produced by separate signers from a common input.
+uint64_t merge_stream( const std::vector< std::string >& filenames, const record_options& opts )
+{
+  std::vector< std::unique_ptr< std::ifstream > > files;
+  std::vector< std::unique_ptr< record_reader > > readers;
+  files.reserve( filenames.size() );
+  readers.reserve( filenames.size() );
+
+  for( const auto& filename: filenames )
+  {
+    files.emplace_back( std::make_unique< std::ifstream >( filename, std::ios::binary ) );
+
+    if( !*files.back() )
+      throw std::runtime_error( "unable to open " + filename );
+
+    readers.emplace_back( std::make_unique< record_reader >( opts.input, *files.back() ) );
+  }
+
+  sign_context ctx;
+  protocol::transaction copy;
+  std::string record;
+  std::string output;
+  uint64_t records = 0;
+  uint64_t errors  = 0;
+
+  while( readers.front()->next( record ) )
+  {
+    records++;
+
+    try
+    {
+      read_transaction( record, opts, ctx );
+      copy.Clear();
+      copy.Swap( &ctx.transaction );
+
+      for( std::size_t i = 1; i < readers.size(); i++ )
+      {
+        if( !readers[ i ]->next( record ) )
+          throw std::runtime_error( filenames[ i ] + " ended before " + filenames.front() );
+
+        read_transaction( record, opts, ctx );
+
+        if( ctx.transaction.id().empty() || ctx.transaction.id() != copy.id() )
+          throw std::runtime_error( "transaction id in " + filenames[ i ] + " does not match " + filenames.front() );
+
+        for( const auto& signature: ctx.transaction.signatures() )
+          add_signature( copy, signature );
+      }
+
+      ctx.transaction.Swap( &copy );
+      write_transaction( opts, ctx, output );
+    }
+    catch( const std::exception& e )
+    {
+      errors++;
+      write_error( records, e.what(), opts, ctx, output );
+    }
+
+    stage_timer timer( stage::write );
+    add_stage_bytes( stage::write, output.size() );
+    std::cout.write( output.data(), output.size() );
+  }
+
+  std::cout.flush();
+
+  // Signatures in records past the end of the first file would otherwise be dropped without notice
+  for( std::size_t i = 1; i < readers.size(); i++ )
+  {
+    if( readers[ i ]->next( record ) )
+    {
+      errors++;
+      LOG( error ) << filenames[ i ] << " has more records than " << filenames.front();
+    }
+  }
+
+  if( errors )
+    LOG( warning ) << "Failed to merge " << errors << " of " << records << " records";
+
+  return errors;
+}
+
+// Progress of a file signing run, saved only once the output it covers is durable
+struct sign_checkpoint
+{
+  uint64_t records       = 0; // Input records whose results are in the output
+  uint64_t output_offset = 0; // Size of the output holding those results
+  uint64_t errors        = 0; // Records among them that failed to sign, still reported by a resumed run
+  std::string input_hash;     // Hash of the input, so a run does not resume over a different file
+  std::string settings_hash;  // Hash of the signing settings, so a run does not resume with different options
+};
+
+// The result of one record of a file signing run
+struct file_result
+{
+  std::string output;
+  bool success = true;
+};
+
+std::string encode_hash( const crypto::multihash& hash )
+{
+  return util::to_hex( util::converter::as< std::string >( hash ) );
+}
+
+std::string read_contents( const std::string& filename )
+{
+  std::ifstream stream( filename, std::ios::binary );
+  if( !stream )
+    throw std::runtime_error( "unable to open " + filename );
+
+  return std::string( std::istreambuf_iterator< char >( stream ), std::istreambuf_iterator< char >() );
+}
+
+// A hash of everything besides the input that shapes the output of a file signing run: the signing keys, formats,
+// finalizing, nonce assignment with its starting nonces and rc estimation with its genesis
+std::string signing_settings_hash( const boost::program_options::variables_map& vm,
+                                   const std::vector< crypto::private_key >& signing_keys,
+                                   const record_options& opts )
+{
+  std::string settings;
+
+  for( const auto& key: signing_keys )
+    settings += key.get_public_key().to_address_bytes();
+
+  settings += " input=" + std::to_string( int( opts.input ) ) + " output=" + std::to_string( int( opts.output ) )
+              + " wrap=" + std::to_string( opts.wrap ) + " unwrap=" + std::to_string( opts.unwrap )
+              + " finalize=" + std::to_string( opts.finalize );
+
+  if( vm.count( ASSIGN_NONCES_OPTION ) )
+  {
+    settings += " " ASSIGN_NONCES_OPTION;
+
+    if( vm.count( NONCE_FILE_OPTION ) )
+      settings += " " NONCE_FILE_OPTION "=" + read_contents( vm[ NONCE_FILE_OPTION ].as< std::string >() );
+  }
+
+  if( opts.estimator )
+  {
+    settings += " " ESTIMATE_RC_OPTION " margin=" + std::to_string( vm[ RC_MARGIN_OPTION ].as< double >() )
+                + " call_compute=" + std::to_string( vm[ CALL_COMPUTE_OPTION ].as< uint64_t >() );
+
+    if( vm.count( RC_GENESIS_OPTION ) )
+      settings += " " RC_GENESIS_OPTION "=" + read_contents( vm[ RC_GENESIS_OPTION ].as< std::string >() );
+  }
+
+  return encode_hash( crypto::hash( crypto::multicodec::sha2_256, settings ) );
+}
+
+void write_fd( int fd, const char* data, std::size_t size, const std::string& filename )
+{
+  while( size )
+  {
+    auto written = ::write( fd, data, size );
+
+    if( written < 0 )
+    {
+      if( errno == EINTR )
+        continue;
+
+      throw std::system_error( errno, std::generic_category(), "unable to write " + filename );
+    }
+
+    data += written;
+    size -= std::size_t( written );
+  }
+}
 
-// Sign the given transaction
-void sign_transaction( protocol::transaction& transaction, crypto::private_key& transaction_signing_key )
+std::optional< sign_checkpoint > load_checkpoint( const std::string& filename )
 {
-  // Signature is on the hash of the active data
-  auto trx_id = crypto::hash( crypto::multicodec::sha2_256, transaction.header() );
-  transaction.set_id( util::converter::as< std::string >( trx_id ) );
-  *transaction.add_signatures() = util::converter::as< std::string >( transaction_signing_key.sign_compact( trx_id ) );
+  std::ifstream instream( filename );
+
+  if( !instream )
+    return {};
+
+  sign_checkpoint checkpoint;
+
+  if( !( instream >> checkpoint.records >> checkpoint.output_offset >> checkpoint.errors >> checkpoint.input_hash
+         >> checkpoint.settings_hash ) )
+    throw std::runtime_error( "unable to read checkpoint " + filename );
+
+  return checkpoint;
 }
 
-// Wrap the given transaction in a request
-rpc::chain::chain_request wrap_transaction( protocol::transaction& transaction )
+// Replace the checkpoint by renaming a synced copy over it, so a crash leaves either the old or the new checkpoint.
+// Resuming from an older checkpoint than the output reached is safe, the output is truncated back to it.
+void save_checkpoint( const std::string& filename, const sign_checkpoint& checkpoint )
 {
-  rpc::chain::chain_request req;
-  auto submit_transaction = req.mutable_submit_transaction();
-  submit_transaction->mutable_transaction()->CopyFrom( transaction );
+  auto temporary = filename + ".tmp";
+  auto contents  = std::to_string( checkpoint.records ) + " " + std::to_string( checkpoint.output_offset ) + " "
+                  + std::to_string( checkpoint.errors ) + " " + checkpoint.input_hash + " " + checkpoint.settings_hash
+                  + "\n";
+
+  int fd = ::open( temporary.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644 );
+  if( fd < 0 )
+    throw std::system_error( errno, std::generic_category(), "unable to open " + temporary );
 
-  return req;
+  try
+  {
+    write_fd( fd, contents.data(), contents.size(), temporary );
+
+    if( ::fsync( fd ) < 0 )
+      throw std::system_error( errno, std::generic_category(), "unable to sync " + temporary );
+  }
+  catch( ... )
+  {
+    ::close( fd );
+    throw;
+  }
+
+  ::close( fd );
+
+  if( std::rename( temporary.c_str(), filename.c_str() ) )
+    throw std::system_error( errno, std::generic_category(), "unable to replace " + filename );
 }
 
-// Read a base58 WIF private key from the given file
-crypto::private_key read_keyfile( std::string key_filename )
+// Appends results to the output file of a file signing run, starting from the offset of the last checkpoint
+class output_file
 {
-  // Read base58 wif string from given file
-  std::string key_string;
-  std::ifstream instream;
-  instream.open( key_filename );
-  std::getline( instream, key_string );
-  instream.close();
-
-  // Create and return the key from the wif
-  auto key = crypto::private_key::from_wif( key_string );
-  return key;
+public:
+  output_file( const std::string& filename, uint64_t offset ):
+      _filename( filename ),
+      _offset( offset )
+  {
+    _fd = ::open( filename.c_str(), O_WRONLY | O_CREAT, 0644 );
+    if( _fd < 0 )
+      throw std::system_error( errno, std::generic_category(), "unable to open " + filename );
+
+    // Drop whatever was written after the checkpoint, it is signed again identically
+    auto size = ::lseek( _fd, 0, SEEK_END );
+    if( size < 0 || uint64_t( size ) < offset || ::ftruncate( _fd, off_t( offset ) ) < 0
+        || ::lseek( _fd, off_t( offset ), SEEK_SET ) < 0 )
+    {
+      ::close( _fd );
+      throw std::runtime_error( filename + " is shorter than its checkpoint" );
+    }
+
+    _buffer.reserve( OUTPUT_BUFFER_SIZE );
+  }
+
+  ~output_file()
+  {
+    ::close( _fd );
+  }
+
+  output_file( const output_file& )            = delete;
+  output_file& operator=( const output_file& ) = delete;
+
+  void write( const std::string& output )
+  {
+    _buffer += output;
+
+    if( _buffer.size() >= OUTPUT_BUFFER_SIZE )
+      flush();
+  }
+
+  // Make everything written so far durable, returning the size of the output
+  uint64_t sync()
+  {
+    flush();
+
+    if( ::fsync( _fd ) < 0 )
+      throw std::system_error( errno, std::generic_category(), "unable to sync " + _filename );
+
+    return _offset;
+  }
+
+private:
+  void flush()
+  {
+    stage_timer timer( stage::write );
+    add_stage_bytes( stage::write, _buffer.size() );
+    write_fd( _fd, _buffer.data(), _buffer.size(), _filename );
+    _offset += _buffer.size();
+    _buffer.clear();
+  }
+
+  std::string _filename;
+  int _fd;
+  uint64_t _offset;
+  std::string _buffer;
+};
+
+// Sign every record of a memory mapped input file into an output file, checkpointing every checkpoint_interval
+// records. A rerun with the same input and settings resumes after the last checkpoint and produces output identical
+// to an uninterrupted run, signing is deterministic and nonces are assigned again to the records before the
+// checkpoint. Returns the number of records of the whole run that failed to sign, including those before the
+// checkpoint.
+uint64_t sign_file( const std::string& input_filename,
+                    const std::string& output_filename,
+                    const std::string& checkpoint_filename,
+                    uint64_t checkpoint_interval,
+                    const std::vector< crypto::private_key >& signing_keys,
+                    std::size_t num_threads,
+                    const record_options& opts,
+                    nonce_tracker* nonces,
+                    const std::string& settings_hash )
+{
+  mapped_records records( input_filename, opts.input );
+  std::string input_hash;
+
+  {
+    stage_timer timer( stage::hash );
+    auto contents = records.contents();
+    input_hash    = encode_hash( crypto::hash( crypto::multicodec::sha2_256, contents.data(), contents.size() ) );
+  }
+
+  sign_checkpoint checkpoint;
+
+  if( auto saved = load_checkpoint( checkpoint_filename ) )
+  {
+    checkpoint = *saved;
+
+    if( checkpoint.input_hash != input_hash || checkpoint.records > records.size() )
+      throw std::runtime_error( "checkpoint " + checkpoint_filename + " is not for " + input_filename );
+
+    if( checkpoint.settings_hash != settings_hash )
+      throw std::runtime_error( "checkpoint " + checkpoint_filename
+                                + " was made with different signing options, rerun with the same options" );
+
+    LOG( info ) << "Resuming after record " << checkpoint.records << " of " << records.size();
+  }
+  else
+  {
+    checkpoint.input_hash    = input_hash;
+    checkpoint.settings_hash = settings_hash;
+  }
+
+  output_file output( output_filename, checkpoint.output_offset );
+
+  sign_context reader_ctx;
+  sign_job job;
+  auto first          = checkpoint.records;
+  auto signed_records = checkpoint.records;
+  auto errors         = checkpoint.errors;
+
+  if( nonces )
+  {
+    for( uint64_t i = 0; i < first; i++ )
+    {
+      job.record.assign( records.record( i ) );
+      assign_job_nonce( opts, *nonces, reader_ctx, job );
+    }
+  }
+
+  std::vector< sign_context > contexts( num_threads );
+
+  // Errors are counted as results are written, so each checkpoint counts exactly the errors in the output it covers
+  ordered_executor< sign_job, file_result > executor(
+    num_threads,
+    num_threads * SIGNING_QUEUE_DEPTH_PER_THREAD,
+    [ & ]( sign_job& input, std::size_t worker )
+    {
+      file_result result;
+      result.success = sign_record( input, signing_keys, opts, contexts[ worker ], result.output );
+      return result;
+    },
+    [ & ]( const file_result& result )
+    {
+      output.write( result.output );
+
+      if( !result.success )
+        errors++;
+
+      if( ++signed_records % checkpoint_interval == 0 )
+      {
+        checkpoint.records       = signed_records;
+        checkpoint.output_offset = output.sync();
+        checkpoint.errors        = errors;
+        save_checkpoint( checkpoint_filename, checkpoint );
+      }
+    } );
+
+  for( auto i = first; i < records.size(); i++ )
+  {
+    job          = sign_job();
+    job.position = i + 1;
+    job.record.assign( records.record( i ) );
+
+    if( nonces )
+      assign_job_nonce( opts, *nonces, reader_ctx, job );
+
+    executor.push( std::move( job ) );
+  }
+
+  executor.finish();
+
+  checkpoint.records       = signed_records;
+  checkpoint.output_offset = output.sync();
+  checkpoint.errors        = errors;
+  save_checkpoint( checkpoint_filename, checkpoint );
+
+  LOG( info ) << "Signed " << signed_records - first << " records, " << signed_records << " of " << records.size()
+              << " complete";
+
+  if( errors )
+    LOG( warning ) << "Failed to sign " << errors << " of " << signed_records << " records";
+
+  return errors;
 }
 
 int main( int argc, char** argv )
@@ -69,8 +618,62 @@ int main( int argc, char** argv )
     boost::program_options::options_description options( "Options" );
     options.add_options()( HELP_OPTION "," HELP_FLAG, "print usage message" )(
       PRIVATE_KEY_OPTION "," PRIVATE_KEY_FLAG,
-      boost::program_options::value< std::string >()->default_value( "private.key" ),
-      "private key file" )( WRAP_OPTION "," WRAP_FLAG, "wrap signed transaction in a request" );
+      boost::program_options::value< std::vector< std::string > >()->composing()->default_value(
+        { "private.key" },
+        "private.key" ),
+      "private key file, repeat to sign with several keys" )(
+      KEYRING_OPTION "," KEYRING_FLAG,
+      boost::program_options::value< std::string >(),
+      "file of WIF private keys, one per line, to sign with instead of private key files" )(
+      WRAP_OPTION "," WRAP_FLAG,
+      "wrap signed transaction in a request" )(
+      UNWRAP_OPTION "," UNWRAP_FLAG,
+      "input transactions are wrapped in a request" )( STREAM_OPTION "," STREAM_FLAG,
+                                                       "sign transactions until EOF, one result per input record" )(
+      THREADS_OPTION "," THREADS_FLAG,
+      boost::program_options::value< std::size_t >()->default_value( 1 ),
+      "number of signing threads when streaming, 0 uses all cores" )(
+      INPUT_FORMAT_OPTION "," INPUT_FORMAT_FLAG,
+      boost::program_options::value< std::string >()->default_value( "json" ),
+      "input format: json, binary (length delimited protobuf) or base64 (one protobuf per line)" )(
+      OUTPUT_FORMAT_OPTION "," OUTPUT_FORMAT_FLAG,
+      boost::program_options::value< std::string >(),
+      "output format: json, compact (single line json), binary or base64 (default json, compact when streaming)" )(
+      FINALIZE_OPTION "," FINALIZE_FLAG,
+      "compute the operation merkle root of transactions that are not already finalized" )(
+      ASSIGN_NONCES_OPTION "," ASSIGN_NONCES_FLAG,
+      "assign sequential nonces per payee, or payer when there is none, to transactions without a nonce" )(
+      NONCE_FILE_OPTION,
+      boost::program_options::value< std::string >(),
+      "file of '<address> <nonce>' lines with the current nonce of each payee or payer" )(
+      MERGE_OPTION "," MERGE_FLAG,
+      boost::program_options::value< std::vector< std::string > >()->multitoken(),
+      "merge the signatures of the same transactions signed separately into each of the given files" )(
+      ESTIMATE_RC_OPTION "," ESTIMATE_RC_FLAG,
+      "set the rc_limit of transactions without one to their estimated rc before signing" )(
+      RC_GENESIS_OPTION,
+      boost::program_options::value< std::string >(),
+      "genesis file with the resource limits and compute registry to estimate with" )(
+      RC_MARGIN_OPTION,
+      boost::program_options::value< double >()->default_value( 10.0 ),
+      "percentage added to the estimated rc for the rc_limit" )(
+      CALL_COMPUTE_OPTION,
+      boost::program_options::value< uint64_t >()->default_value( 0 ),
+      "compute charged for the contract code run by each call_contract operation when estimating" )(
+      INPUT_FILE_OPTION,
+      boost::program_options::value< std::string >(),
+      "sign every record of a file instead of STDIN, resuming from its checkpoint if one exists" )(
+      OUTPUT_FILE_OPTION,
+      boost::program_options::value< std::string >(),
+      "file to write the results of --" INPUT_FILE_OPTION " to" )(
+      CHECKPOINT_OPTION,
+      boost::program_options::value< std::string >(),
+      "checkpoint file of --" INPUT_FILE_OPTION ", defaults to the output file with a .checkpoint suffix" )(
+      CHECKPOINT_INTERVAL_OPTION,
+      boost::program_options::value< uint64_t >()->default_value( 100'000 ),
+      "records signed between checkpoints of --" INPUT_FILE_OPTION );
+
+    add_stats_options( options );
 
     // Parse command-line options
     boost::program_options::variables_map vm;
@@ -81,50 +684,154 @@ int main( int argc, char** argv )
     {
       std::cout << "Koinos Transaction Signing Tool" << std::endl;
       std::cout << "Accepts a json transaction to sign via STDIN" << std::endl;
-      std::cout << "Returns the signed transaction via STDOUT" << std::endl << std::endl;
+      std::cout << "Returns the signed transaction via STDOUT" << std::endl;
+      std::cout << "With --" STREAM_OPTION ", accepts one transaction per record and returns one result per record"
+                << std::endl;
+      std::cout << "With --" MERGE_OPTION ", combines the signatures of separately signed copies of a batch"
+                << std::endl;
+      std::cout << "With --" INPUT_FILE_OPTION ", signs a file of records resumably, one result per input record"
+                << std::endl
+                << std::endl;
       std::cout << options << std::endl;
       return EXIT_SUCCESS;
     }
 
+    auto stats = make_stats_reporter( vm, "koinos_transaction_signer" );
+
     // Read options into variables
-    std::string key_filename = vm[ PRIVATE_KEY_OPTION ].as< std::string >();
-    bool wrap                = vm.count( WRAP_OPTION );
+    auto key_filenames = vm[ PRIVATE_KEY_OPTION ].as< std::vector< std::string > >();
+    bool stream        = vm.count( STREAM_OPTION );
+    auto num_threads   = vm[ THREADS_OPTION ].as< std::size_t >();
 
-    // Read the keyfile
-    auto private_key = read_keyfile( key_filename );
+    if( !num_threads )
+      num_threads = ordered_executor< std::string, std::string >::default_concurrency();
 
-    // Read STDIN to a string
-    std::string transaction_json;
-    std::getline( std::cin, transaction_json );
+    auto input_format  = parse_record_format( vm[ INPUT_FORMAT_OPTION ].as< std::string >() );
+    auto output_format = stream || vm.count( MERGE_OPTION ) || vm.count( INPUT_FILE_OPTION ) ? record_format::compact
+                                                                                            : record_format::json;
 
-    // Parse and deserialize the json to a transaction
-    google::protobuf::util::JsonParseOptions json_opts;
-    json_opts.ignore_unknown_fields         = true;
-    json_opts.case_insensitive_enum_parsing = true;
+    if( vm.count( OUTPUT_FORMAT_OPTION ) )
+      output_format = parse_record_format( vm[ OUTPUT_FORMAT_OPTION ].as< std::string >() );
 
-    protocol::transaction transaction;
-    google::protobuf::util::JsonStringToMessage( transaction_json, &transaction, json_opts );
+    auto opts     = make_record_options( input_format, output_format );
+    opts.wrap     = vm.count( WRAP_OPTION );
+    opts.unwrap   = vm.count( UNWRAP_OPTION );
+    opts.finalize = vm.count( FINALIZE_OPTION );
 
-    // Sign the transaction
-    sign_transaction( transaction, private_key );
+    // The estimator must outlive every signing worker that reads it through opts
+    auto estimator = rc_estimator();
+
+    if( vm.count( ESTIMATE_RC_OPTION ) )
+    {
+      if( vm.count( RC_GENESIS_OPTION ) )
+      {
+        auto filename = vm[ RC_GENESIS_OPTION ].as< std::string >();
+        std::ifstream stream( filename, std::ios::binary );
+        if( !stream )
+          throw std::runtime_error( "unable to open genesis file " + filename );
+
+        estimator = rc_estimator::from_genesis( stream, genesis_format::automatic );
+      }
+
+      estimator.set_margin( vm[ RC_MARGIN_OPTION ].as< double >() );
+      estimator.set_call_compute( vm[ CALL_COMPUTE_OPTION ].as< uint64_t >() );
+      opts.estimator = &estimator;
+    }
 
-    google::protobuf::util::JsonPrintOptions print_options;
-    print_options.add_whitespace                = true;
-    print_options.always_print_primitive_fields = true;
-    print_options.preserve_proto_field_names    = true;
+    if( vm.count( MERGE_OPTION ) )
+    {
+      std::ios::sync_with_stdio( false );
+
+      auto errors = merge_stream( vm[ MERGE_OPTION ].as< std::vector< std::string > >(), opts );
+      return errors ? EXIT_FAILURE : EXIT_SUCCESS;
+    }
+
+    std::unique_ptr< nonce_tracker > nonces;
+
+    if( vm.count( ASSIGN_NONCES_OPTION ) )
+    {
+      nonces = std::make_unique< nonce_tracker >();
+
+      if( vm.count( NONCE_FILE_OPTION ) )
+        nonces->load( vm[ NONCE_FILE_OPTION ].as< std::string >() );
+    }
+
+    // Read the keyfiles
+    std::vector< crypto::private_key > signing_keys;
+
+    if( vm.count( KEYRING_OPTION ) )
+    {
+      signing_keys = read_keyring( vm[ KEYRING_OPTION ].as< std::string >() );
+    }
+    else
+    {
+      for( const auto& key_filename: key_filenames )
+        signing_keys.emplace_back( read_keyfile( key_filename ) );
+    }
+
+    if( signing_keys.empty() )
+      throw std::runtime_error( "no private keys to sign with" );
 
-    std::string json_str;
+    if( vm.count( INPUT_FILE_OPTION ) )
+    {
+      if( !vm.count( OUTPUT_FILE_OPTION ) )
+        throw std::runtime_error( "--" INPUT_FILE_OPTION " requires --" OUTPUT_FILE_OPTION );
+
+      auto output_filename     = vm[ OUTPUT_FILE_OPTION ].as< std::string >();
+      auto checkpoint_filename = vm.count( CHECKPOINT_OPTION ) ? vm[ CHECKPOINT_OPTION ].as< std::string >()
+                                                               : output_filename + ".checkpoint";
+      auto checkpoint_interval = vm[ CHECKPOINT_INTERVAL_OPTION ].as< uint64_t >();
+
+      if( !checkpoint_interval )
+        throw std::runtime_error( "--" CHECKPOINT_INTERVAL_OPTION " must be at least 1" );
+
+      auto errors = sign_file( vm[ INPUT_FILE_OPTION ].as< std::string >(),
+                               output_filename,
+                               checkpoint_filename,
+                               checkpoint_interval,
+                               signing_keys,
+                               num_threads,
+                               opts,
+                               nonces.get(),
+                               signing_settings_hash( vm, signing_keys, opts ) );
+      return errors ? EXIT_FAILURE : EXIT_SUCCESS;
+    }
 
-    if( wrap ) // Wrap the transaction if requested
+    if( stream )
     {
-      auto request = wrap_transaction( transaction );
-      google::protobuf::util::MessageToJsonString( request, &json_str, print_options );
-      std::cout << json_str << std::endl;
+      std::ios::sync_with_stdio( false );
+
+      auto errors = sign_stream( signing_keys, num_threads, opts, nonces.get() );
+      return errors ? EXIT_FAILURE : EXIT_SUCCESS;
     }
-    else // Else simply output the signed transaction
+
+    // Read a single transaction from STDIN
+    record_reader reader( opts.input );
+    std::string record;
+
+    if( !reader.next( record ) )
+      throw std::runtime_error( "no transaction received on STDIN" );
+
+    sign_context ctx;
+    read_transaction( record, opts, ctx );
+
+    if( nonces )
+      nonces->assign( ctx.transaction );
+
+    prepare_transaction( ctx.transaction, opts, signing_keys.size() );
+
+    // Sign the transaction
+    sign_transaction( ctx.transaction, signing_keys );
+
+    // Output the signed transaction, wrapped in a request if requested
+    std::string output;
+    write_transaction( opts, ctx, output );
+
     {
-      google::protobuf::util::MessageToJsonString( transaction, &json_str, print_options );
-      std::cout << json_str << std::endl;
+      stage_timer timer( stage::write );
+      add_stage_bytes( stage::write, output.size() );
+      std::cout.write( output.data(), output.size() );
+      std::cout.flush();
     }
 
     return EXIT_SUCCESS;
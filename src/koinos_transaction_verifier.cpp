@@ -0,0 +1,302 @@
+#include <atomic>
+#include <chrono>
+#include <fstream>
+#include <iostream>
+#include <unordered_set>
+#include <vector>
+
+#include <boost/program_options.hpp>
+
+#include <google/protobuf/struct.pb.h>
+#include <google/protobuf/util/json_util.h>
+
+#include <koinos/exception.hpp>
+#include <koinos/log.hpp>
+#include <koinos/util/base58.hpp>
+#include <koinos/util/base64.hpp>
+
+#include <koinos/tools/ordered_executor.hpp>
+#include <koinos/tools/records.hpp>
+#include <koinos/tools/signing.hpp>
+#include <koinos/tools/stats.hpp>
+#include <koinos/tools/verification.hpp>
+
+#include <koinos/protocol/protocol.pb.h>
+#include <koinos/rpc/chain/chain_rpc.pb.h>
+
+// Command line option definitions
+#define HELP_OPTION "help"
+#define HELP_FLAG   "h"
+
+#define INPUT_FORMAT_OPTION "input-format"
+#define INPUT_FORMAT_FLAG   "i"
+
+#define OUTPUT_FORMAT_OPTION "output-format"
+#define OUTPUT_FORMAT_FLAG   "o"
+
+#define UNWRAP_OPTION "unwrap"
+#define UNWRAP_FLAG   "u"
+
+#define SIGNER_OPTION "signer"
+#define SIGNER_FLAG   "s"
+
+#define SIGNER_FILE_OPTION "signer-file"
+
+#define REQUIRE_PAYER_OPTION "require-payer"
+#define REQUIRE_PAYER_FLAG   "p"
+
+#define CHAIN_ID_OPTION "chain-id"
+#define CHAIN_ID_FLAG   "c"
+
+#define FILTER_OPTION "filter"
+#define FILTER_FLAG   "f"
+
+#define THREADS_OPTION "threads"
+#define THREADS_FLAG   "t"
+
+// Records in flight per verifying thread, bounds memory regardless of input size
+const std::size_t VERIFY_QUEUE_DEPTH_PER_THREAD = 256;
+
+using namespace koinos;
+using namespace koinos::tools;
+
+struct verify_job
+{
+  uint64_t position = 0;
+  std::string record;
+};
+
+// Scratch state reused across records by a single thread
+struct verify_context
+{
+  sign_context sign;
+  verify_result result;
+};
+
+// Read "<base58 address>" lines into a set of address bytes
+void load_signers( const std::string& filename, std::unordered_set< std::string >& signers )
+{
+  std::ifstream instream( filename );
+
+  if( !instream )
+    throw std::runtime_error( "unable to open " + filename );
+
+  std::string line;
+
+  while( std::getline( instream, line ) )
+  {
+    if( !line.empty() )
+      signers.insert( util::from_base58< std::string >( line ) );
+  }
+}
+
+// A single line json report of the result of one record
+void write_result( uint64_t position, const std::string& id, verify_context& ctx, std::string& output )
+{
+  output = "{\"record\":" + std::to_string( position ) + ",\"id\":\"" + util::to_base64( id ) + "\",\"valid\":"
+           + ( ctx.result.valid() ? "true" : "false" ) + ",\"signers\":[";
+
+  for( std::size_t i = 0; i < ctx.result.signers.size(); i++ )
+  {
+    if( i )
+      output += ",";
+    output += "\"" + util::to_base58( ctx.result.signers[ i ] ) + "\"";
+  }
+
+  output += "],\"errors\":[";
+
+  for( std::size_t i = 0; i < ctx.result.errors.size(); i++ )
+  {
+    std::string error_str;
+    ctx.sign.error.set_string_value( ctx.result.errors[ i ] );
+    google::protobuf::util::MessageToJsonString( ctx.sign.error, &error_str );
+
+    if( i )
+      output += ",";
+    output += error_str;
+  }
+
+  output += "]}\n";
+}
+
+// Verify a single record into output: its report, or the transaction itself when filtering and it is valid.
+// Returns false if the record is invalid.
+bool verify_record( const verify_job& job,
+                    const verify_options& vopts,
+                    const record_options& opts,
+                    bool filter,
+                    verify_context& ctx,
+                    std::string& output )
+{
+  output.clear();
+
+  try
+  {
+    read_transaction( job.record, opts, ctx.sign );
+    verify_transaction( ctx.sign.transaction, vopts, ctx.result );
+  }
+  catch( const std::exception& e )
+  {
+    ctx.sign.transaction.Clear();
+    ctx.result.signers.clear();
+    ctx.result.errors.assign( 1, e.what() );
+  }
+
+  if( !filter )
+    write_result( job.position, ctx.sign.transaction.id(), ctx, output );
+  else if( ctx.result.valid() )
+    serialize_record( ctx.sign.transaction, opts, output );
+  else
+    LOG( error ) << "Record " << job.position << ": " << ctx.result.errors.front();
+
+  return ctx.result.valid();
+}
+
+int main( int argc, char** argv )
+{
+  try
+  {
+    // Setup command line options
+    boost::program_options::options_description options( "Options" );
+    options.add_options()( HELP_OPTION "," HELP_FLAG, "print usage message" )(
+      INPUT_FORMAT_OPTION "," INPUT_FORMAT_FLAG,
+      boost::program_options::value< std::string >()->default_value( "json" ),
+      "input format: json, binary (length delimited protobuf) or base64 (one protobuf per line)" )(
+      OUTPUT_FORMAT_OPTION "," OUTPUT_FORMAT_FLAG,
+      boost::program_options::value< std::string >()->default_value( "compact" ),
+      "format of the transactions passed through by --" FILTER_OPTION ": json, compact, binary or base64" )(
+      UNWRAP_OPTION "," UNWRAP_FLAG,
+      "input transactions are wrapped in a request" )(
+      SIGNER_OPTION "," SIGNER_FLAG,
+      boost::program_options::value< std::vector< std::string > >()->composing(),
+      "base58 address allowed to sign, repeat for several, any signer is accepted when none are given" )(
+      SIGNER_FILE_OPTION,
+      boost::program_options::value< std::string >(),
+      "file of base58 addresses allowed to sign, one per line" )(
+      REQUIRE_PAYER_OPTION "," REQUIRE_PAYER_FLAG,
+      "require a signature from the payer, and from the payee as well when one is set" )(
+      CHAIN_ID_OPTION "," CHAIN_ID_FLAG,
+      boost::program_options::value< std::string >(),
+      "base64 chain id transactions must be for" )(
+      FILTER_OPTION "," FILTER_FLAG,
+      "write only the valid transactions instead of a result per record, invalid records go to the log" )(
+      THREADS_OPTION "," THREADS_FLAG,
+      boost::program_options::value< std::size_t >()->default_value( 0 ),
+      "number of verifying threads, 0 uses all cores" );
+
+    add_stats_options( options );
+
+    // Parse command-line options
+    boost::program_options::variables_map vm;
+    boost::program_options::store( boost::program_options::parse_command_line( argc, argv, options ), vm );
+
+    // Handle help message
+    if( vm.count( HELP_OPTION ) )
+    {
+      std::cout << "Koinos Transaction Verifier" << std::endl;
+      std::cout << "Accepts signed transactions via STDIN and checks their ids, operation merkle roots and signatures"
+                << std::endl;
+      std::cout << "Returns a single line json result per input record via STDOUT" << std::endl;
+      std::cout << "With --" FILTER_OPTION ", returns only the valid transactions" << std::endl << std::endl;
+      std::cout << options << std::endl;
+      return EXIT_SUCCESS;
+    }
+
+    auto stats = make_stats_reporter( vm, "koinos_transaction_verifier" );
+
+    auto num_threads = vm[ THREADS_OPTION ].as< std::size_t >();
+    bool filter      = vm.count( FILTER_OPTION );
+
+    if( !num_threads )
+      num_threads = ordered_executor< verify_job, std::string >::default_concurrency();
+
+    auto input_format  = parse_record_format( vm[ INPUT_FORMAT_OPTION ].as< std::string >() );
+    auto output_format = parse_record_format( vm[ OUTPUT_FORMAT_OPTION ].as< std::string >() );
+    auto opts          = make_record_options( input_format, output_format );
+    opts.unwrap        = vm.count( UNWRAP_OPTION );
+
+    verify_options vopts;
+    vopts.require_payer = vm.count( REQUIRE_PAYER_OPTION );
+
+    if( vm.count( CHAIN_ID_OPTION ) )
+      vopts.chain_id = util::from_base64< std::string >( vm[ CHAIN_ID_OPTION ].as< std::string >() );
+
+    if( vm.count( SIGNER_OPTION ) )
+    {
+      for( const auto& address: vm[ SIGNER_OPTION ].as< std::vector< std::string > >() )
+        vopts.signers.insert( util::from_base58< std::string >( address ) );
+    }
+
+    if( vm.count( SIGNER_FILE_OPTION ) )
+    {
+      load_signers( vm[ SIGNER_FILE_OPTION ].as< std::string >(), vopts.signers );
+
+      if( vopts.signers.empty() )
+        throw std::runtime_error( "no signers in " + vm[ SIGNER_FILE_OPTION ].as< std::string >() );
+    }
+
+    // Results are written from the verifying workers while this thread reads
+    std::ios::sync_with_stdio( false );
+    std::cin.tie( nullptr );
+
+    record_reader reader( opts.input );
+    std::vector< verify_context > contexts( num_threads );
+    verify_job job;
+    uint64_t records                = 0;
+    std::atomic< uint64_t > invalid = 0;
+
+    auto start = std::chrono::steady_clock::now();
+
+    ordered_executor< verify_job, std::string > executor(
+      num_threads,
+      num_threads * VERIFY_QUEUE_DEPTH_PER_THREAD,
+      [ & ]( verify_job& input, std::size_t worker )
+      {
+        std::string output;
+        if( !verify_record( input, vopts, opts, filter, contexts[ worker ], output ) )
+          invalid++;
+        return output;
+      },
+      []( const std::string& output )
+      {
+        stage_timer timer( stage::write );
+        add_stage_bytes( stage::write, output.size() );
+        std::cout.write( output.data(), output.size() );
+      } );
+
+    while( reader.next( job.record ) )
+    {
+      records++;
+      job.position = reader.position();
+      executor.push( std::move( job ) );
+      job = verify_job();
+    }
+
+    executor.finish();
+    std::cout.flush();
+
+    auto elapsed = std::chrono::duration< double >( std::chrono::steady_clock::now() - start ).count();
+    LOG( info ) << "Verified " << records << " records in " << elapsed << "s ("
+                << ( elapsed > 0 ? uint64_t( records / elapsed ) : 0 ) << " records/s) on " << num_threads
+                << " threads";
+
+    if( invalid )
+      LOG( warning ) << invalid << " of " << records << " records are invalid";
+
+    return invalid ? EXIT_FAILURE : EXIT_SUCCESS;
+  }
+  catch( const boost::exception& e )
+  {
+    LOG( fatal ) << boost::diagnostic_information( e ) << std::endl;
+  }
+  catch( const std::exception& e )
+  {
+    LOG( fatal ) << e.what() << std::endl;
+  }
+  catch( ... )
+  {
+    LOG( fatal ) << "unknown exception" << std::endl;
+  }
+
+  return EXIT_FAILURE;
+}